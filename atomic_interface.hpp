@@ -0,0 +1,138 @@
+#ifndef ATOMIC_INTERFACE_HPP_INCLUDED
+#define ATOMIC_INTERFACE_HPP_INCLUDED
+
+#include<atomic>
+#include<thread>
+#include<type_traits>
+#include<utility>
+#include<cstddef>
+
+#include "interface.hpp"
+
+namespace interface_detail
+{
+    // Hazard slots are kept on separate cache lines so that readers don't contend.
+    inline constexpr std::size_t cache_line = 64;
+
+    struct alignas(cache_line) hazard_slot
+    {
+        std::atomic<const void*> p{nullptr};
+    };
+
+    // Index of the calling thread, each thread starts searching for a free slot at its own.
+    inline std::size_t thread_index() noexcept
+    {
+        static std::atomic<std::size_t> next{0};
+        thread_local std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+}
+
+// Slot holding an interface I that may be loaded and called through by any number of threads
+// while others store a new one, without locks on either side.
+// The interface is kept on the heap and swapped by pointer. Readers publish the pointer they
+// loaded in one of Slots hazard slots, writers wait until no slot holds the pointer they swapped
+// out before destroying it.
+template<typename I, std::size_t Slots = 64>
+class atomic_interface
+{
+    static_assert(::interface_detail::is_interface_v<I>, "atomic_interface requires an interface.");
+    static_assert(Slots > 0, "atomic_interface requires at least one hazard slot.");
+
+  public:
+    // Guards the loaded interface against destruction while alive.
+    // Readers may only call methods, which the stored object must make safe to call concurrently.
+    // Non-const methods of shared interfaces unshare the object, hence readers of those may only call const methods.
+    class snapshot
+    {
+      public:
+        snapshot() = default;
+        snapshot(snapshot&& other) noexcept
+            : _p{::std::exchange(other._p, nullptr)}, _slot{::std::exchange(other._slot, nullptr)}
+        {
+        }
+        snapshot& operator=(snapshot other) noexcept
+        {
+            ::std::swap(_p, other._p);
+            ::std::swap(_slot, other._slot);
+            return *this;
+        }
+        ~snapshot()
+        {
+            if(_slot)
+                _slot->p.store(nullptr, ::std::memory_order_release);
+        }
+
+        I& operator*() const noexcept { return *_p; }
+        I* operator->() const noexcept { return _p; }
+
+        // Returns true if the loaded interface holds an object.
+        explicit operator bool() const noexcept { return _p && *_p; }
+
+      private:
+        friend class atomic_interface;
+        snapshot(I* p, ::interface_detail::hazard_slot* slot) noexcept : _p{p}, _slot{slot} {}
+
+        I* _p = nullptr;
+        ::interface_detail::hazard_slot* _slot = nullptr;
+    };
+
+    atomic_interface() = default;
+    explicit atomic_interface(I i) : _p{new I(::std::move(i))} {}
+    atomic_interface(const atomic_interface&) = delete;
+    atomic_interface& operator=(const atomic_interface&) = delete;
+
+    // No snapshot may outlive the atomic_interface.
+    ~atomic_interface() { delete _p.load(::std::memory_order_relaxed); }
+
+    // Lock-free as long as fewer than Slots snapshots are alive.
+    snapshot load() const noexcept
+    {
+        auto start = ::interface_detail::thread_index();
+        for(::std::size_t k = 0;; ++k)
+        {
+            auto p = _p.load();
+            if(!p)
+                return {};
+
+            // Publishes p, then checks it wasn't swapped out before a writer could see it.
+            auto& slot = _slots[(start + k) % Slots];
+            const void* expected = nullptr;
+            if(!slot.p.compare_exchange_strong(expected, p))
+                continue;
+            if(_p.load() == p)
+                return {p, &slot};
+            slot.p.store(nullptr, ::std::memory_order_release);
+        }
+    }
+
+    // Waits for readers of the previous interface before destroying it,
+    // hence the calling thread must not hold a snapshot of this.
+    void store(I i) { exchange(::std::move(i)); }
+
+    // Returns the previous interface once no reader refers to it, as store.
+    I exchange(I i)
+    {
+        auto old = _p.exchange(new I(::std::move(i)));
+        if(!old)
+            return {};
+        retire(old);
+        I ret = ::std::move(*old);
+        delete old;
+        return ret;
+    }
+
+  private:
+    // Spins until no hazard slot holds p, which is no longer reachable by new readers.
+    void retire(const I* p) const noexcept
+    {
+        for(auto& slot : _slots)
+            while(slot.p.load() == p)
+                ::std::this_thread::yield();
+    }
+
+    ::std::atomic<I*> _p{nullptr};
+    mutable ::interface_detail::hazard_slot _slots[Slots];
+};
+
+#endif // ATOMIC_INTERFACE_HPP_INCLUDED
@@ -0,0 +1,270 @@
+// Micro-benchmarks of interface against virtual functions, std::function and std::variant.
+// Self-contained, build with optimizations from the repository root, eg
+//
+//     g++ -std=c++17 -O2 -DNDEBUG -I. bench/benchmark.cpp -o benchmark -pthread && ./benchmark
+//
+// Prints nanoseconds per operation, the minimum over several runs.
+// Objects of different types alternate so that calls can't be devirtualized.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include "atomic_interface.hpp"
+#include "interface.hpp"
+
+namespace
+{
+    constexpr int count = 1024;
+    constexpr int rounds = 1000;
+    constexpr int runs = 5;
+
+    volatile long sink;
+
+    // Keeps the compiler from optimizing away t.
+    template<typename T>
+    void escape(T& t)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r"(&t) : "memory");
+#else
+        static const void* volatile p;
+        p = &t;
+#endif
+    }
+
+    template<typename F>
+    void measure(const char* name, F f)
+    {
+        double best = 1e300;
+        for(int r = 0; r < runs; ++r)
+        {
+            auto start = std::chrono::steady_clock::now();
+            long acc = 0;
+            for(int k = 0; k < rounds; ++k)
+                acc += f();
+            sink = acc;
+            std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - start;
+            best = std::min(best, d.count() / (double(rounds) * count));
+        }
+        std::printf("%-40s %8.3f ns\n", name, best);
+    }
+
+    // Methods m0..m7, the last method of each interface is called.
+    template<int N>
+    struct small
+    {
+        int n = N;
+        int m0() { return n; }
+        int m1() { return n + 1; }
+        int m2() { return n + 2; }
+        int m3() { return n + 3; }
+        int m4() { return n + 4; }
+        int m5() { return n + 5; }
+        int m6() { return n + 6; }
+        int m7() { return n + 7; }
+    };
+
+    template<int N>
+    struct large : small<N>
+    {
+        char pad[128] = {};
+    };
+
+    using I1 = INTERFACE(int(), m0);
+    using I2 = INTERFACE(int(), m0, int(), m1);
+    using I3 = INTERFACE(int(), m0, int(), m1, int(), m2);
+    using I4 = INTERFACE(int(), m0, int(), m1, int(), m2, int(), m3);
+    using I5 = INTERFACE(int(), m0, int(), m1, int(), m2, int(), m3, int(), m4);
+    using I6 = INTERFACE(int(), m0, int(), m1, int(), m2, int(), m3, int(), m4, int(), m5);
+    using I7 = INTERFACE(int(), m0, int(), m1, int(), m2, int(), m3, int(), m4, int(), m5, int(), m6);
+    using I8 = INTERFACE(int(), m0, int(), m1, int(), m2, int(), m3, int(), m4, int(), m5, int(), m6, int(), m7);
+
+    template<typename I, typename Call>
+    void dispatch(const char* name, Call call)
+    {
+        std::vector<I> v;
+        for(int k = 0; k < count; ++k)
+            k % 2 ? v.push_back(small<0>{}) : v.push_back(small<1>{});
+        measure(name, [&] {
+            long acc = 0;
+            for(auto& i : v)
+                acc += call(i);
+            return acc;
+        });
+    }
+
+    struct base
+    {
+        virtual ~base() = default;
+        virtual int m0() = 0;
+    };
+    template<int N>
+    struct derived : base
+    {
+        int n = N;
+        int m0() override { return n; }
+    };
+
+    void dispatch_baselines()
+    {
+        std::vector<std::unique_ptr<base>> b;
+        std::vector<std::function<int()>> f;
+        std::vector<std::variant<small<0>, small<1>>> v;
+        for(int k = 0; k < count; ++k)
+        {
+            if(k % 2)
+            {
+                b.push_back(std::make_unique<derived<0>>());
+                f.push_back([s = small<0>{}]() mutable { return s.m0(); });
+                v.push_back(small<0>{});
+            }
+            else
+            {
+                b.push_back(std::make_unique<derived<1>>());
+                f.push_back([s = small<1>{}]() mutable { return s.m0(); });
+                v.push_back(small<1>{});
+            }
+        }
+        measure("dispatch virtual", [&] {
+            long acc = 0;
+            for(auto& p : b)
+                acc += p->m0();
+            return acc;
+        });
+        measure("dispatch std::function", [&] {
+            long acc = 0;
+            for(auto& g : f)
+                acc += g();
+            return acc;
+        });
+        measure("dispatch std::variant visit", [&] {
+            long acc = 0;
+            for(auto& x : v)
+                acc += std::visit([](auto& s) { return s.m0(); }, x);
+            return acc;
+        });
+    }
+
+    // Runs f on background threads while measuring it on this one.
+    template<typename F>
+    void contended(const char* name, F f)
+    {
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> threads;
+        for(int t = 0; t < 3; ++t)
+            threads.emplace_back([&] {
+                long acc = 0;
+                while(!stop.load(std::memory_order_relaxed))
+                    acc += f();
+                escape(acc);
+            });
+        measure(name, f);
+        stop = true;
+        for(auto& t : threads)
+            t.join();
+    }
+
+    // Calls through a slot shared between threads.
+    void dispatch_shared()
+    {
+        atomic_interface<I1> a{small<0>{}};
+        contended("dispatch atomic_interface load", [&] {
+            long acc = 0;
+            for(int k = 0; k < count; ++k)
+                acc += a.load()->m0();
+            return acc;
+        });
+
+        I1 i = small<0>{};
+        std::mutex m;
+        contended("dispatch std::mutex guarded", [&] {
+            long acc = 0;
+            for(int k = 0; k < count; ++k)
+            {
+                std::lock_guard<std::mutex> lock{m};
+                acc += i.m0();
+            }
+            return acc;
+        });
+    }
+
+    // Constructs and destroys count interfaces from t.
+    template<typename I, typename T>
+    void construct(const char* name, T t)
+    {
+        measure(name, [&] {
+            long acc = 0;
+            for(int k = 0; k < count; ++k)
+            {
+                I i = t;
+                escape(i);
+                acc += static_cast<bool>(i);
+            }
+            return acc;
+        });
+    }
+
+    // Applies op to count copies of an interface holding t.
+    template<typename I, typename T, typename Op>
+    void transform(const char* name, T t, Op op)
+    {
+        std::vector<I> v(count, I{t});
+        measure(name, [&] {
+            long acc = 0;
+            for(auto& i : v)
+                acc += op(i);
+            return acc;
+        });
+    }
+}
+
+int main()
+{
+    dispatch<I1>("dispatch 1 method", [](I1& i) { return i.m0(); });
+    dispatch<I2>("dispatch 2 methods", [](I2& i) { return i.m1(); });
+    dispatch<I3>("dispatch 3 methods", [](I3& i) { return i.m2(); });
+    dispatch<I4>("dispatch 4 methods", [](I4& i) { return i.m3(); });
+    dispatch<I5>("dispatch 5 methods", [](I5& i) { return i.m4(); });
+    dispatch<I6>("dispatch 6 methods", [](I6& i) { return i.m5(); });
+    dispatch<I7>("dispatch 7 methods", [](I7& i) { return i.m6(); });
+    dispatch<I8>("dispatch 8 methods", [](I8& i) { return i.m7(); });
+    dispatch_baselines();
+    dispatch_shared();
+
+    static small<0> object;
+    construct<I8>("construct small", small<0>{});
+    construct<I8>("construct large", large<0>{});
+    construct<I8>("construct pointer", &object);
+    construct<std::function<int()>>("construct std::function small", [s = small<0>{}]() mutable { return s.m0(); });
+    construct<std::function<int()>>("construct std::function large", [s = large<0>{}]() mutable { return s.m0(); });
+
+    transform<I8>("copy small", small<0>{}, [](I8& i) { I8 j = i; escape(j); return static_cast<bool>(j); });
+    transform<I8>("copy large", large<0>{}, [](I8& i) { I8 j = i; escape(j); return static_cast<bool>(j); });
+    transform<I8>("copy assign large", large<0>{}, [j = I8{large<1>{}}](I8& i) { i = j; return static_cast<bool>(i); });
+    transform<I8>("move small", small<0>{}, [](I8& i) {
+        I8 j = std::move(i);
+        escape(j);
+        i = std::move(j);
+        return static_cast<bool>(i);
+    });
+    transform<I8>("move large", large<0>{}, [](I8& i) {
+        I8 j = std::move(i);
+        escape(j);
+        i = std::move(j);
+        return static_cast<bool>(i);
+    });
+    transform<I8>("emplace small", small<0>{}, [](I8& i) { i.emplace<small<0>>(); return static_cast<bool>(i); });
+    transform<I8>("emplace large", large<0>{}, [](I8& i) { i.emplace<large<0>>(); return static_cast<bool>(i); });
+    transform<I8>("convert 8 methods to 1 small", small<0>{}, [](I8& i) { I1 j = i; escape(j); return static_cast<bool>(j); });
+    transform<I8>("convert 8 methods to 1 large", large<0>{}, [](I8& i) { I1 j = i; escape(j); return static_cast<bool>(j); });
+    transform<I8>("target hit", small<0>{}, [](I8& i) { return target<small<0>>(i) != nullptr; });
+    transform<I8>("target miss", small<0>{}, [](I8& i) { return target<small<1>>(i) != nullptr; });
+}
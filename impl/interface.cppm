@@ -0,0 +1,1696 @@
+// DO NOT modify, this is a machine generated file.
+// C++20 module interface unit of everything but the macros, see impl/README for details.
+// Macros can't be exported, import through interface_module.hpp for them.
+
+module;
+
+#include<atomic>
+#include<exception>
+#include<functional>
+#include<memory>
+#include<memory_resource>
+#include<new>
+#include<tuple>
+#include<type_traits>
+#include<utility>
+#include<cstddef>
+#include<cstdint>
+#include<cstring>
+
+export module interface;
+
+export
+{
+// Thrown when an interface reference to an object that isn't copy constructible is converted to
+// an owning interface, which copies the object. Its type is only known at run time.
+struct bad_interface_copy : std::exception
+{
+    const char* what() const noexcept override { return "bad_interface_copy"; }
+};
+
+// Implementaion namespace.
+namespace interface_detail
+{
+    struct interface_tag {}; // As extra parameter for certain implementation functions to avoid namespace pollution.
+
+    template<typename T>
+    struct is_interface : std::is_base_of<interface_tag, T> {};
+
+    template<typename T>
+    inline constexpr bool is_interface_v = is_interface<T>::value;
+
+    template<typename T>
+    struct is_in_place_type : std::false_type {};
+
+    template<typename T>
+    struct is_in_place_type<std::in_place_type_t<T>> : std::true_type {};
+
+    template<typename T>
+    inline constexpr bool is_in_place_type_v = is_in_place_type<T>::value;
+
+    // Base case factory for type erased method call.
+    // Shouldn't be called. Working factories within the defined interface.
+    struct nothing
+    {
+        template<typename... Args>
+        void call(void*, Args&&...) noexcept {}
+        template<typename... Args>
+        void call_const(const void*, Args&&...) noexcept {}
+    };
+
+    // Parameter type of the type erased call for a parameter A of the interface signature.
+    // With INTERFACE_FORWARD_ARGUMENTS, objects are passed by rvalue reference so that only
+    // the target's parameter is constructed. Scalars and references are passed as is.
+    // Must be defined consistently across translation units.
+#ifdef INTERFACE_FORWARD_ARGUMENTS
+    template<typename A>
+    using param_t = std::conditional_t<std::is_scalar_v<A> || std::is_reference_v<A>, A, A&&>;
+#else
+    template<typename A>
+    using param_t = A;
+#endif // INTERFACE_FORWARD_ARGUMENTS
+
+    // erasure_fn is a traits class that handles void return types gracefully.
+    template<typename Signature, typename Factory = nothing>
+    struct erasure_fn;
+
+    template<typename Ret, typename... Args, typename Factory>
+    struct erasure_fn<Ret(Args...), Factory> : Factory
+    {
+        using type = Ret(void*, param_t<Args>...);
+        using return_type = Ret;
+        static constexpr Ret value(void* p, param_t<Args>... args)
+        {
+            if constexpr(std::is_void_v<Ret>)
+                Factory::call(p, std::forward<Args>(args)...);
+            else
+                return Factory::call(p, std::forward<Args>(args)...);
+        };
+    };
+
+    // noexcept signatures give noexcept type erased calls, and require noexcept methods.
+    template<typename Ret, typename... Args, typename Factory>
+    struct erasure_fn<Ret(Args...) noexcept, Factory> : Factory
+    {
+        using type = Ret(void*, param_t<Args>...) noexcept;
+        using return_type = Ret;
+        static constexpr Ret value(void* p, param_t<Args>... args) noexcept
+        {
+            static_assert(noexcept(Factory::call(p, std::forward<Args>(args)...)),
+                          "Methods of noexcept signatures must be noexcept.");
+            if constexpr(std::is_void_v<Ret>)
+                Factory::call(p, std::forward<Args>(args)...);
+            else
+                return Factory::call(p, std::forward<Args>(args)...);
+        };
+    };
+
+    // Const methods are called through a const object and may be called on const interfaces.
+    template<typename Ret, typename... Args, typename Factory>
+    struct erasure_fn<Ret(Args...) const, Factory> : Factory
+    {
+        using type = Ret(const void*, param_t<Args>...);
+        using return_type = Ret;
+        static constexpr Ret value(const void* p, param_t<Args>... args)
+        {
+            if constexpr(std::is_void_v<Ret>)
+                Factory::call_const(p, std::forward<Args>(args)...);
+            else
+                return Factory::call_const(p, std::forward<Args>(args)...);
+        };
+    };
+
+    template<typename Ret, typename... Args, typename Factory>
+    struct erasure_fn<Ret(Args...) const noexcept, Factory> : Factory
+    {
+        using type = Ret(const void*, param_t<Args>...) noexcept;
+        using return_type = Ret;
+        static constexpr Ret value(const void* p, param_t<Args>... args) noexcept
+        {
+            static_assert(noexcept(Factory::call_const(p, std::forward<Args>(args)...)),
+                          "Methods of noexcept signatures must be noexcept.");
+            if constexpr(std::is_void_v<Ret>)
+                Factory::call_const(p, std::forward<Args>(args)...);
+            else
+                return Factory::call_const(p, std::forward<Args>(args)...);
+        };
+    };
+
+    template<typename Signature>
+    struct is_const_signature : std::false_type {};
+
+    template<typename Ret, typename... Args>
+    struct is_const_signature<Ret(Args...) const> : std::true_type {};
+
+    template<typename Ret, typename... Args>
+    struct is_const_signature<Ret(Args...) const noexcept> : std::true_type {};
+
+    // Extra parameters delay evaluation until instantiation.
+    template<typename Signature, typename...>
+    inline constexpr bool is_const_signature_v = is_const_signature<Signature>::value;
+
+    // Converts an argument of an interface method for the type erased call.
+    // Lvalues bound to by reference parameters are copied, as a by value parameter would be.
+    template<typename P, typename A>
+    std::enable_if_t<std::is_rvalue_reference_v<P> && std::is_lvalue_reference_v<A>, std::remove_reference_t<P>>
+    forward_param(A&& a) noexcept(std::is_nothrow_copy_constructible_v<std::remove_reference_t<P>>)
+    {
+        return a;
+    }
+    template<typename P, typename A>
+    std::enable_if_t<!(std::is_rvalue_reference_v<P> && std::is_lvalue_reference_v<A>), A&&>
+    forward_param(A&& a) noexcept
+    {
+        return std::forward<A>(a);
+    }
+
+    // Calls a type erased method, Obj is const void for const methods.
+    // noexcept if the method is and the arguments convert without throwing.
+    template<typename Ret, typename Obj, typename... Params, bool NoExcept, typename... Args>
+    Ret invoke(Ret (*f)(Obj*, Params...) noexcept(NoExcept), void* p, Args&&... args)
+        noexcept(noexcept(f(p, forward_param<Params, Args>(std::forward<Args>(args))...)))
+    {
+        return f(p, forward_param<Params, Args>(std::forward<Args>(args))...);
+    }
+
+    // Whether calling a method of Signature with Args can't throw.
+    template<typename Signature, typename... Args>
+    inline constexpr bool is_nothrow_call_v = noexcept(::interface_detail::invoke(
+        std::declval<typename erasure_fn<Signature>::type*>(), nullptr, std::declval<Args>()...));
+
+    // Non-const methods of shared interfaces unshare the object before the call, which may throw.
+    template<typename Layout, typename Signature, typename... Args>
+    inline constexpr bool is_nothrow_method_v =
+        is_nothrow_call_v<Signature, Args...> && (!Layout::shared || is_const_signature_v<Signature>);
+
+    // Whether a type erased call of type Fn may mutate the object, which const methods take as const void*.
+    template<typename Fn>
+    struct is_mutating_call : std::false_type {};
+
+    template<typename Ret, typename... Params, bool NoExcept>
+    struct is_mutating_call<Ret(void*, Params...) noexcept(NoExcept)> : std::true_type {};
+
+    // Whether no method of Vtable may mutate the object, then interface references may refer to const objects.
+    template<typename Vtable>
+    struct is_const_vtable;
+
+    template<typename... Fns>
+    struct is_const_vtable<std::tuple<Fns...>>
+        : std::bool_constant<!(is_mutating_call<std::remove_pointer_t<Fns>>::value || ...)> {};
+
+    // Return type of a type erased call through a pointer Fn.
+    template<typename Fn>
+    struct call_return;
+
+    template<typename Ret, typename Obj, typename... Params, bool NoExcept>
+    struct call_return<Ret (*)(Obj*, Params...) noexcept(NoExcept)>
+    {
+        using type = Ret;
+    };
+
+    template<typename Fn>
+    using call_return_t = typename call_return<Fn>::type;
+
+    // Unified interface to access stored object.
+    // Stored pointer signifies reference semantics, in which case p is the pointee itself.
+    template<typename T>
+    decltype(auto) as_object(void* p) noexcept
+    {
+        if constexpr(std::is_pointer_v<T>)
+            return *static_cast<T>(p);
+        else
+            return *static_cast<T*>(p);
+    }
+    template<typename T>
+    decltype(auto) as_const_object(const void* p) noexcept
+    {
+        return std::as_const(as_object<T>(const_cast<void*>(p)));
+    }
+
+    // Result of target, pointers held for reference semantics are returned by value.
+    template<typename T>
+    using target_t = std::conditional_t<std::is_pointer_v<T>, T, T*>;
+    template<typename T>
+    using const_target_t = std::conditional_t<std::is_pointer_v<T>, T, const T*>;
+
+    // Inline buffer for small objects, size is set through generate.go -sbo.
+    inline constexpr std::size_t sbo_size = 3 * sizeof(void*);
+    inline constexpr std::size_t sbo_align = alignof(std::max_align_t);
+
+    // Whether T is stored in the inline buffer instead of the heap.
+    // Nothrow move is required for interface moves and swaps to stay noexcept.
+    template<typename T>
+    inline constexpr bool is_inline_v = sizeof(T) <= sbo_size && alignof(T) <= sbo_align &&
+                                               std::is_nothrow_move_constructible_v<T>;
+
+    // Type erased special member functions.
+    // Packed into a single cache line along with the first methods of a method_table,
+    // the fields read by every destruction, move and target come first.
+    struct thunk
+    {
+        void (*destroy)(void* p) noexcept = nullptr;
+        const thunk* type = nullptr; // The thunk acting as RTTI.
+        void (*move)(void* dst, void* src) = nullptr;
+        void (*copy)(void* dst, const void* src) = nullptr;
+        std::uint32_t size = 0;
+        std::uint32_t align = 0;
+        bool is_inline : 1;
+        bool is_trivially_relocatable : 1; // Inline objects may be moved by copying bytes.
+        bool nothrow_copy : 1; // Copies may be made into the buffer of the destroyed object.
+        bool (*equal)(const void* x, const void* y) = nullptr;
+    };
+
+    // Type erased copy and move, null if T isn't copy or move constructible respectively.
+    // The copy is also null unless Copyable, so that it isn't instantiated for unique interfaces.
+    // Types of copyable interfaces whose move constructor is deleted are copied in place of moves.
+    template<typename T, bool Copyable = true>
+    constexpr auto copy_fn() -> void (*)(void*, const void*)
+    {
+        if constexpr(Copyable && std::is_constructible_v<T, const T&>)
+            return [](void* dst, const void* src) {
+                new (dst) T{*static_cast<const T*>(src)};
+            };
+        else
+            return nullptr;
+    }
+    template<typename T, bool Copyable = true>
+    constexpr auto move_fn() -> void (*)(void*, void*)
+    {
+        if constexpr(std::is_constructible_v<T, T&&>)
+            return [](void* dst, void* src) {
+                new (dst) T{std::move(*static_cast<T*>(src))};
+            };
+        else if constexpr(Copyable && std::is_constructible_v<T, const T&>)
+            return [](void* dst, void* src) {
+                new (dst) T{std::as_const(*static_cast<T*>(src))};
+            };
+        else
+            return nullptr;
+    }
+
+    template<typename T, typename = void>
+    struct is_equality_comparable : std::false_type {};
+
+    template<typename T>
+    struct is_equality_comparable<T, std::void_t<decltype(bool(std::declval<const T&>() == std::declval<const T&>()))>>
+        : std::true_type {};
+
+    // Type erased operator==, null if T isn't equality comparable or without INTERFACE_VALUE_EQUALITY.
+    // Opt in since operator== of some types, such as std::vector, is declared even if it can't be instantiated.
+    // Must be defined consistently across translation units.
+    template<typename T>
+    constexpr auto equal_fn() -> bool (*)(const void*, const void*)
+    {
+#ifdef INTERFACE_VALUE_EQUALITY
+        if constexpr(is_equality_comparable<T>::value)
+            return [](const void* x, const void* y) -> bool {
+                return *static_cast<const T*>(x) == *static_cast<const T*>(y);
+            };
+        else
+#endif // INTERFACE_VALUE_EQUALITY
+            return nullptr;
+    }
+
+    // Address of the thunk without copy acts as RTTI, the one with copy refers to it through type.
+    // Copy constructors of some types, such as of a std::vector of std::unique_ptr, are declared
+    // even if they can't be instantiated, hence the thunk without copy is never instantiated along with it.
+    template<typename T, bool Copyable>
+    struct thunk_storage
+    {
+        static_assert(sizeof(T) <= UINT32_MAX, "Objects stored in interfaces must be smaller than 4GiB.");
+
+        inline static constexpr thunk t = {
+            [](void* p) noexcept {
+                static_cast<T*>(p)->~T();
+            },
+            &thunk_storage<T, false>::t,
+            move_fn<T, Copyable>(),
+            copy_fn<T, Copyable>(),
+            sizeof(T),
+            alignof(T),
+            is_inline_v<T>,
+            std::is_trivially_copyable_v<T>,
+            std::is_nothrow_copy_constructible_v<T>,
+            equal_fn<T>()
+        };
+    };
+
+    // Pointers aren't stored as objects, the pointee is kept directly by storage.
+    // Defined out of class, so that t may refer to itself as RTTI.
+    template<>
+    struct thunk_storage<void*, false>
+    {
+        static const thunk t;
+    };
+
+    inline constexpr thunk thunk_storage<void*, false>::t = {
+        nullptr,
+        &t,
+        nullptr,
+        nullptr,
+        sizeof(void*),
+        alignof(void*),
+        false,
+        true,
+        true,
+        nullptr
+    };
+
+    // The thunk of T acting as RTTI, or with Copyable the one with copy.
+    template<typename T, bool Copyable = false>
+    constexpr const thunk* get_thunk()
+    {
+        // Returns same thunk for all pointer types, used to determine whether
+        // interface has reference semantics.
+        if constexpr (std::is_pointer_v<T>)
+            return &thunk_storage<void*, false>::t;
+        else
+            return &thunk_storage<T, Copyable>::t;
+    }
+
+    // All pointer thunks are void* thunks.
+    constexpr bool is_pointer_thunk(const thunk* t)
+    {
+        return t == get_thunk<void*>();
+    }
+
+    // Descriptor of the stored type, a pointer to the method_table of the interface that stored it,
+    // or the sealed_index of a sealed interface. storage reaches the special member functions through thunk_of,
+    // and the thunk acting as RTTI through type_of.
+    constexpr const thunk* thunk_of(const thunk* t) noexcept
+    {
+        return t;
+    }
+    constexpr const thunk* type_of(const thunk* t) noexcept
+    {
+        return t->type;
+    }
+
+    // Methods of a type shared by all interfaces of the same type storing that type.
+    // The thunk is copied in so that destruction, target and dispatch read the same cache line,
+    // which the alignment keeps from straddling two.
+    // Its copy is null for unique interfaces, which never copy.
+    template<typename Vtable>
+    struct alignas(64) method_table : thunk
+    {
+        Vtable vtable;
+    };
+
+    // Alignment of heap buffers, at least that of new.
+    constexpr std::size_t heap_align(std::size_t align) noexcept
+    {
+        return align > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? align : __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    }
+
+    // Deleter of heap buffers, a null memory resource means new[] and delete[],
+    // or the aligned operator new and delete for overaligned buffers.
+    struct deallocator
+    {
+        std::pmr::memory_resource* mr = nullptr;
+        std::size_t size = 0;
+        std::size_t align = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+        void operator()(std::byte* p) const noexcept
+        {
+#ifdef INTERFACE_ALLOCATION_HOOK
+            INTERFACE_ALLOCATION_HOOK::deallocate(size, align, mr);
+#endif // INTERFACE_ALLOCATION_HOOK
+            if(mr)
+                mr->deallocate(p, size, align);
+            else if(align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+                ::operator delete(p, size, std::align_val_t{align});
+            else
+                delete[] p;
+        }
+    };
+
+    // Exception safe buffer allocation.
+    // With INTERFACE_ALLOCATION_HOOK defined as a type Hook, each buffer is reported to
+    // Hook::allocate(size, align, mr) once allocated and Hook::deallocate(size, align, mr) before
+    // it is freed, both noexcept, mr null for new and delete. Must be defined consistently across translation units.
+    inline std::unique_ptr<std::byte[], deallocator> allocate(std::size_t size, std::size_t align, std::pmr::memory_resource* mr)
+    {
+        align = heap_align(align);
+        std::byte* p;
+        if(mr)
+            p = static_cast<std::byte*>(mr->allocate(size, align));
+        else if(align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            p = static_cast<std::byte*>(::operator new(size, std::align_val_t{align}));
+        else
+            p = new std::byte[size];
+#ifdef INTERFACE_ALLOCATION_HOOK
+        INTERFACE_ALLOCATION_HOOK::allocate(size, align, mr);
+#endif // INTERFACE_ALLOCATION_HOOK
+        return {p, deallocator{mr, size, align}};
+    }
+
+    // Coroutine types, the return types of coroutines such as tasks, name their promise_type.
+    template<typename T, typename = void>
+    struct is_coroutine_type : std::false_type {};
+
+    template<typename T>
+    struct is_coroutine_type<T, std::void_t<typename T::promise_type>> : std::true_type {};
+
+    // Memory resource of the interface whose method returning a coroutine type is being called,
+    // coroutine frames are allocated from it by interface_frame_allocator. Null means new and delete.
+    inline thread_local std::pmr::memory_resource* frame_resource = nullptr;
+
+    // Sets frame_resource for the duration of a call returning Ret, if it is a coroutine type.
+    template<typename Ret, bool = is_coroutine_type<Ret>::value>
+    struct frame_scope
+    {
+        constexpr explicit frame_scope(std::pmr::memory_resource*) noexcept {}
+    };
+
+    template<typename Ret>
+    struct frame_scope<Ret, true>
+    {
+        explicit frame_scope(std::pmr::memory_resource* mr) noexcept : _prev{std::exchange(frame_resource, mr)} {}
+        frame_scope(const frame_scope&) = delete;
+        frame_scope& operator=(const frame_scope&) = delete;
+        ~frame_scope() { frame_resource = _prev; }
+
+      private:
+        std::pmr::memory_resource* _prev;
+    };
+
+    // Reference counts of shared heap objects, kept in front of the object.
+    // unshared storage has none and deep copies instead.
+    struct unshared {};
+    using local_count = std::size_t;
+    using atomic_count = std::atomic<std::size_t>;
+
+    inline void acquire(local_count& c) noexcept { ++c; }
+    inline bool release(local_count& c) noexcept { return --c == 0; }
+    inline bool is_unique(const local_count& c) noexcept { return c == 1; }
+
+    inline void acquire(atomic_count& c) noexcept { c.fetch_add(1, std::memory_order_relaxed); }
+    inline bool release(atomic_count& c) noexcept { return c.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+    inline bool is_unique(const atomic_count& c) noexcept { return c.load(std::memory_order_acquire) == 1; }
+
+    // Owns the type erased object, identified by its descriptor Desc, null when empty.
+    // Small objects live in the inline buffer, the rest are allocated on the heap.
+    // Inline objects are relocated on move, hence pointers to them are invalidated.
+    // Pointers are not owned, _ptr holds the pointee without allocating.
+    // Objects record their memory resource, copies allocate from the same resource.
+    // With a Count, copies share heap objects from the same resource, which are only
+    // copied when unshared. Inline objects are always copied.
+    template<typename Desc, typename Count = unshared>
+    class basic_storage
+    {
+      public:
+        static constexpr bool shared = !std::is_same_v<Count, unshared>;
+        static constexpr bool sealed = false;
+        static constexpr bool owning = true;
+        using count_type = Count;
+
+      private:
+
+        // Offset of heap objects from the start of their buffer, leaving room for the count.
+        static constexpr std::size_t header(std::size_t align) noexcept { return shared ? heap_align(align) : 0; }
+        static_assert(!shared || sizeof(Count) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Count must fit in front of the object.");
+
+      public:
+        basic_storage() = default;
+        basic_storage(const basic_storage& other) { copy(other, other.resource()); }
+        basic_storage(basic_storage&& other) noexcept { relocate(other); }
+        ~basic_storage() { reset(); }
+
+        // Unshared heap objects that are nothrow copy constructible are copied into the buffer of
+        // the held object if it has the same size, alignment and resource.
+        // Otherwise, copies and swaps. Both have the strong guarantee.
+        basic_storage& operator=(const basic_storage& other)
+        {
+            if(this == &other)
+                return *this;
+            if constexpr(!shared)
+            {
+                if(other.on_heap())
+                {
+                    auto t = thunk_of(other._t);
+                    auto size = header(t->align) + t->size;
+                    if(t->nothrow_copy && reusable(size, t->align, other._mr))
+                    {
+                        reconstruct(other._t, size, t->align, [&](void* p) { t->copy(p, other._ptr); });
+                        return *this;
+                    }
+                }
+            }
+            auto tmp = other;
+            swap(*this, tmp);
+            return *this;
+        }
+        basic_storage& operator=(basic_storage&& other) noexcept
+        {
+            if(this != &other)
+            {
+                reset();
+                relocate(other);
+            }
+            return *this;
+        }
+
+        // Constructs a U from args in place of the stored object, which is destroyed first.
+        // Heap objects are allocated from mr if not null, an unshared heap buffer of the same
+        // size, alignment and resource is reused instead. Storage is left empty if construction throws.
+        template<typename U, typename... Args>
+        void emplace(Desc d, std::pmr::memory_resource* mr, Args&&... args)
+        {
+            if constexpr(!std::is_pointer_v<U> && !is_inline_v<U>)
+            {
+                auto size = header(alignof(U)) + sizeof(U);
+                if(reusable(size, alignof(U), mr))
+                    return reconstruct(d, size, alignof(U), [&](void* p) { new (p) U{std::forward<Args>(args)...}; });
+            }
+            reset();
+            if constexpr(std::is_pointer_v<U>)
+                _ptr = const_cast<void*>(static_cast<const volatile void*>(U(std::forward<Args>(args)...)));
+            else
+            {
+                if constexpr(is_inline_v<U>)
+                    _ptr = new (_buf) U{std::forward<Args>(args)...};
+                else
+                {
+                    auto buf = allocate(header(alignof(U)) + sizeof(U), alignof(U), mr);
+                    _ptr = new (buf.get() + header(alignof(U))) U{std::forward<Args>(args)...};
+                    if constexpr(shared)
+                        new (buf.get()) Count{1};
+                    buf.release();
+                }
+                _mr = mr;
+            }
+            if(_ptr)
+                _t = d;
+        }
+
+        // Copy and move constructs from an object described by d, storage must be empty.
+        // Caller guarantees the thunk's move is valid, and its copy unless p is referred to by
+        // an interface reference, which throws bad_interface_copy if it isn't.
+        void copy(const void* p, Desc d, std::pmr::memory_resource* mr)
+        {
+            auto t = thunk_of(d);
+            if(is_pointer_thunk(type_of(d)))
+                refer(const_cast<void*>(p), d);
+            else if(!t->copy)
+                throw bad_interface_copy{};
+            else
+                construct(d, mr, [&](void* dst) { t->copy(dst, p); });
+        }
+        void move(void* p, Desc d, std::pmr::memory_resource* mr)
+        {
+            auto t = thunk_of(d);
+            if(is_pointer_thunk(type_of(d)))
+                refer(p, d);
+            else
+                construct(d, mr, [&](void* dst) { t->move(dst, p); });
+        }
+
+        // Copy and move constructs the object of other, storage must be empty.
+        void copy(const basic_storage& other, std::pmr::memory_resource* mr)
+        {
+            if constexpr(shared)
+            {
+                if(other.on_heap() && other._mr == mr)
+                {
+                    acquire(other.count());
+                    _ptr = other._ptr;
+                    _t = other._t;
+                    _mr = mr;
+                    return;
+                }
+            }
+            if(other._ptr)
+                copy(other._ptr, other._t, mr);
+        }
+        void move(basic_storage& other, std::pmr::memory_resource* mr)
+        {
+            if(other._ptr)
+                move(other._ptr, other._t, mr);
+        }
+
+        // Takes over a heap object released from storage with the same Count and resource.
+        void adopt(void* p, Desc d, std::pmr::memory_resource* mr) noexcept
+        {
+            _ptr = p;
+            _t = d;
+            _mr = mr;
+        }
+
+        // Gives up the heap object if it is allocated from mr with the same count, leaving storage empty.
+        // Returns null and keeps the object otherwise.
+        template<typename C>
+        void* release_ptr(std::pmr::memory_resource* mr) noexcept
+        {
+            if constexpr(std::is_same_v<C, Count>)
+            {
+                if(on_heap() && _mr == mr)
+                {
+                    auto p = _ptr;
+                    _ptr = nullptr;
+                    _t = {};
+                    _mr = nullptr;
+                    return p;
+                }
+            }
+            return nullptr;
+        }
+
+        void reset() noexcept
+        {
+            if(!_ptr)
+                return;
+            auto t = thunk_of(_t);
+            if(!is_pointer_thunk(type_of(_t)))
+            {
+                bool last = true;
+                if constexpr(shared)
+                    last = t->is_inline || release(count());
+                if(last)
+                {
+                    t->destroy(_ptr);
+                    if(!t->is_inline)
+                    {
+                        auto h = header(t->align);
+                        deallocator{_mr, h + t->size, heap_align(t->align)}(static_cast<std::byte*>(_ptr) - h);
+                    }
+                }
+            }
+            _ptr = nullptr;
+            _t = {};
+            _mr = nullptr;
+        }
+
+        constexpr void* ptr() const noexcept { return _ptr; }
+        constexpr Desc desc() const noexcept { return _t; }
+        constexpr const thunk* type() const noexcept { return _t ? type_of(_t) : nullptr; }
+
+        // Special member functions of the object, whose copy converting interfaces use, null if empty.
+        constexpr const thunk* object_thunk() const noexcept { return _t ? thunk_of(_t) : nullptr; }
+
+        // Memory resource of the object, null if new and delete are used or if there is none.
+        // Inline objects keep theirs for copies and coroutine frames, even though they don't allocate.
+        constexpr std::pmr::memory_resource* resource() const noexcept { return _mr; }
+
+        constexpr bool is_inline() const noexcept { return _ptr && thunk_of(_t)->is_inline; }
+
+        // Bytes of the heap buffer, including the count in front of shared objects, 0 if not on the heap.
+        std::size_t heap_size() const noexcept { return on_heap() ? header(thunk_of(_t)->align) + thunk_of(_t)->size : 0; }
+
+        // Gives this storage its own copy of a shared heap object.
+        void unshare()
+        {
+            if constexpr(shared)
+            {
+                if(on_heap() && !is_unique(count()))
+                {
+                    basic_storage tmp;
+                    tmp.copy(_ptr, _t, _mr);
+                    swap(*this, tmp);
+                }
+            }
+        }
+
+        // Pointer to the stored object, pointers for reference semantics are returned as held.
+        // Mutable access unshares the object first.
+        template<typename T>
+        target_t<T> get() noexcept(!shared)
+        {
+            if constexpr(std::is_pointer_v<T>)
+                return static_cast<T>(_ptr);
+            else
+            {
+                unshare();
+                return static_cast<T*>(_ptr);
+            }
+        }
+        template<typename T>
+        const_target_t<T> get() const noexcept
+        {
+            if constexpr(std::is_pointer_v<T>)
+                return static_cast<T>(_ptr);
+            else
+                return static_cast<const T*>(_ptr);
+        }
+
+        friend void swap(basic_storage& x, basic_storage& y) noexcept
+        {
+            // Heap objects are swapped by pointer, trivially relocatable inline objects by bytes,
+            // other inline objects must be relocated.
+            if(x.is_trivially_relocatable() && y.is_trivially_relocatable())
+            {
+                std::swap(x._ptr, y._ptr);
+                std::swap(x._t, y._t);
+                std::swap(x._mr, y._mr);
+                std::byte tmp[sbo_size];
+                std::memcpy(tmp, x._buf, sbo_size);
+                std::memcpy(x._buf, y._buf, sbo_size);
+                std::memcpy(y._buf, tmp, sbo_size);
+                if(x.is_inline())
+                    x._ptr = std::launder(x._buf);
+                if(y.is_inline())
+                    y._ptr = std::launder(y._buf);
+                return;
+            }
+            basic_storage tmp = std::move(x);
+            x = std::move(y);
+            y = std::move(tmp);
+        }
+
+      private:
+        bool is_trivially_relocatable() const noexcept { return !is_inline() || thunk_of(_t)->is_trivially_relocatable; }
+        bool on_heap() const noexcept { return _ptr && !is_inline() && !is_pointer_thunk(type_of(_t)); }
+
+        // Whether the heap object is unshared and its buffer, from mr, has exactly size bytes aligned to align.
+        bool reusable(std::size_t size, std::size_t align, std::pmr::memory_resource* mr) const noexcept
+        {
+            if(!on_heap() || _mr != mr)
+                return false;
+            if constexpr(shared)
+            {
+                if(!is_unique(count()))
+                    return false;
+            }
+            auto t = thunk_of(_t);
+            return header(t->align) + t->size == size && heap_align(t->align) == heap_align(align);
+        }
+
+        // Destroys the heap object, then constructs one described by d with f into its buffer,
+        // which must be reusable for size bytes aligned to align. Storage is left empty if f throws.
+        template<typename F>
+        void reconstruct(Desc d, std::size_t size, std::size_t align, F&& f)
+        {
+            auto h = header(align);
+            auto p = static_cast<std::byte*>(_ptr);
+            auto mr = _mr;
+            thunk_of(_t)->destroy(_ptr);
+            std::unique_ptr<std::byte[], deallocator> buf{p - h, deallocator{mr, size, heap_align(align)}};
+            _ptr = nullptr;
+            _t = {};
+            _mr = nullptr;
+            f(p);
+            buf.release();
+            _ptr = std::launder(p);
+            _t = d;
+            _mr = mr;
+        }
+
+        // Only valid for heap objects of shared storage.
+        Count& count() const noexcept
+        {
+            auto h = header(thunk_of(_t)->align);
+            return *std::launder(reinterpret_cast<Count*>(static_cast<std::byte*>(_ptr) - h));
+        }
+
+        void refer(void* p, Desc d) noexcept
+        {
+            _ptr = p;
+            if(_ptr)
+                _t = d;
+        }
+
+        template<typename F>
+        void construct(Desc d, std::pmr::memory_resource* mr, F&& f)
+        {
+            auto t = thunk_of(d);
+            if(t->is_inline)
+            {
+                f(_buf);
+                _ptr = std::launder(_buf);
+            }
+            else
+            {
+                auto h = header(t->align);
+                auto buf = allocate(h + t->size, t->align, mr);
+                f(buf.get() + h);
+
+                // Avoid [basic.life]/8 where original pointer cannot be used to refer to the newly
+                // constructed object.
+                _ptr = std::launder(buf.get() + h);
+                if constexpr(shared)
+                    new (buf.get()) Count{1};
+                buf.release();
+            }
+            _t = d;
+            _mr = mr;
+        }
+
+        // Takes over the object of other, which is left empty.
+        void relocate(basic_storage& other) noexcept
+        {
+            if(!other._ptr)
+                return;
+            if(!other.is_inline())
+                _ptr = other._ptr;
+            else if(thunk_of(other._t)->is_trivially_relocatable)
+            {
+                // Copying the whole buffer is a fixed size copy the compiler inlines, unlike the size of the type.
+                std::memcpy(_buf, other._buf, sbo_size);
+                _ptr = std::launder(_buf);
+            }
+            else
+            {
+                auto t = thunk_of(other._t);
+                t->move(_buf, other._ptr);
+                t->destroy(other._ptr);
+                _ptr = std::launder(_buf);
+            }
+            _t = other._t;
+            _mr = other._mr;
+            other._ptr = nullptr;
+            other._t = {};
+            other._mr = nullptr;
+        }
+
+        // The buffer comes first so that its alignment doesn't pad the pointers.
+        alignas(sbo_align) std::byte _buf[sbo_size];
+        void* _ptr = nullptr;
+        Desc _t = {};
+        std::pmr::memory_resource* _mr = nullptr;
+    };
+
+    // Layouts decide where an interface keeps its methods.
+    // All are built from the method_table the interface generates for each stored type.
+
+    // Keeps the methods within each object, which allows converting from other interfaces by name.
+    template<typename Vtable, typename Count>
+    class basic_object_layout : public basic_storage<const thunk*, Count>
+    {
+        using base = basic_storage<const thunk*, Count>;
+
+      public:
+        template<typename U, typename... Args>
+        void emplace(const method_table<Vtable>* m, std::pmr::memory_resource* mr, Args&&... args)
+        {
+            base::template emplace<U>(m, mr, std::forward<Args>(args)...);
+            _vtable = m->vtable;
+        }
+        void copy(const void* p, const thunk* t, const Vtable& vtable, std::pmr::memory_resource* mr)
+        {
+            base::copy(p, t, mr);
+            _vtable = vtable;
+        }
+        void move(void* p, const thunk* t, const Vtable& vtable, std::pmr::memory_resource* mr)
+        {
+            base::move(p, t, mr);
+            _vtable = vtable;
+        }
+        void adopt(void* p, const thunk* t, const Vtable& vtable, std::pmr::memory_resource* mr) noexcept
+        {
+            base::adopt(p, t, mr);
+            _vtable = vtable;
+        }
+        void copy(const basic_object_layout& other, std::pmr::memory_resource* mr)
+        {
+            base::copy(other, mr);
+            _vtable = other._vtable;
+        }
+        void move(basic_object_layout& other, std::pmr::memory_resource* mr)
+        {
+            base::move(other, mr);
+            _vtable = other._vtable;
+        }
+
+        constexpr const Vtable& vtable() const noexcept { return _vtable; }
+
+        friend void swap(basic_object_layout& x, basic_object_layout& y) noexcept
+        {
+            swap(static_cast<base&>(x), static_cast<base&>(y));
+            std::swap(x._vtable, y._vtable);
+        }
+
+      private:
+        Vtable _vtable = {};
+    };
+
+    template<typename Vtable>
+    using object_layout = basic_object_layout<Vtable, unshared>;
+
+    // Copies share heap objects, counted atomically or not.
+    template<typename Vtable>
+    using shared_layout = basic_object_layout<Vtable, atomic_count>;
+    template<typename Vtable>
+    using local_shared_layout = basic_object_layout<Vtable, local_count>;
+
+    // Keeps only a pointer to the shared method_table, the size is independent of the number of methods.
+    template<typename Vtable>
+    class compact_layout : public basic_storage<const method_table<Vtable>*>
+    {
+      public:
+        using basic_storage<const method_table<Vtable>*>::copy;
+        using basic_storage<const method_table<Vtable>*>::move;
+
+        // A method_table can't be formed for a type erased by another interface.
+        void copy(const void* p, const thunk* t, const Vtable& vtable, std::pmr::memory_resource* mr) = delete;
+        void move(void* p, const thunk* t, const Vtable& vtable, std::pmr::memory_resource* mr) = delete;
+        void adopt(void* p, const thunk* t, const Vtable& vtable, std::pmr::memory_resource* mr) = delete;
+
+        constexpr const Vtable& vtable() const noexcept { return this->desc()->vtable; }
+
+        friend void swap(compact_layout& x, compact_layout& y) noexcept
+        {
+            using base = basic_storage<const method_table<Vtable>*>;
+            swap(static_cast<base&>(x), static_cast<base&>(y));
+        }
+    };
+
+    // Move only version of a layout.
+    template<typename Layout>
+    class move_only : public Layout
+    {
+      public:
+        move_only() = default;
+        move_only(move_only&&) = default;
+        move_only(const move_only&) = delete;
+        move_only& operator=(move_only&&) = default;
+        move_only& operator=(const move_only&) = delete;
+
+        friend void swap(move_only& x, move_only& y) noexcept
+        {
+            swap(static_cast<Layout&>(x), static_cast<Layout&>(y));
+        }
+    };
+
+    template<typename Vtable>
+    using unique_layout = move_only<object_layout<Vtable>>;
+
+    template<typename T>
+    struct type_tag
+    {
+        using type = T;
+    };
+
+    // Borrowed object of an interface lvalue, as returned by borrow.
+    // Converts to other interfaces as if it were I holding a pointer to the object,
+    // giving them reference semantics without copying.
+    template<typename I>
+    class borrowed : public interface_tag
+    {
+      public:
+        explicit borrowed(I& i) noexcept : _i{i} {}
+
+        // Methods are looked up in I.
+        operator const I&() const noexcept { return _i; }
+        explicit operator bool() const noexcept { return static_cast<bool>(_i); }
+
+        friend void* fetch_ptr(const borrowed& b, interface_tag) { return fetch_ptr(b._i, interface_tag{}); }
+        friend const thunk* fetch_thunk(const borrowed&, interface_tag) { return get_thunk<void*>(); }
+        friend std::pmr::memory_resource* fetch_resource(const borrowed&, interface_tag) { return nullptr; }
+        friend constexpr bool owns_object(const borrowed*, interface_tag) { return false; }
+
+        template<typename C>
+        friend void* release_ptr(const borrowed&, std::pmr::memory_resource*, type_tag<C>, interface_tag) noexcept
+        {
+            return nullptr;
+        }
+
+      private:
+        I& _i;
+    };
+
+    template<std::size_t K, typename F>
+    struct flat_slot
+    {
+        F f = nullptr;
+    };
+
+    // Trivially copyable Vtable, which std::tuple isn't.
+    // Each function pointer is a base, so that it is usable in constant expressions.
+    template<typename Vtable, typename = std::make_index_sequence<std::tuple_size_v<Vtable>>>
+    struct flat_vtable;
+
+    template<typename... Fs, std::size_t... Ks>
+    struct flat_vtable<std::tuple<Fs...>, std::index_sequence<Ks...>> : flat_slot<Ks, Fs>...
+    {
+        flat_vtable() = default;
+        constexpr flat_vtable(const std::tuple<Fs...>& vtable) noexcept : flat_slot<Ks, Fs>{std::get<Ks>(vtable)}... {}
+
+        template<std::size_t K>
+        friend constexpr auto get(const flat_vtable& v) noexcept
+        {
+            return static_cast<const flat_slot<K, std::tuple_element_t<K, std::tuple<Fs...>>>&>(v).f;
+        }
+    };
+
+    // Whether interface references may refer to a shared instance in place of temporaries of T.
+    template<typename T>
+    inline constexpr bool is_stateless_v = std::is_empty_v<T> && std::is_trivially_default_constructible_v<T> &&
+                                                  std::is_trivially_destructible_v<T>;
+
+    // The instance referred to for temporaries of stateless types.
+    template<typename T>
+    inline T stateless_instance{};
+
+    // Refers to objects without owning them, never allocates and is trivially copyable.
+    // Objects are referred to directly, pointers to objects are held as reference semantics.
+    // Constructing from pointers, lvalues and stateless types is usable in constant expressions.
+    template<typename Vtable>
+    class ref_layout
+    {
+      public:
+        static constexpr bool shared = false;
+        static constexpr bool sealed = false;
+        static constexpr bool owning = false;
+        using count_type = unshared;
+
+        template<typename U, typename Arg>
+        constexpr void emplace(const method_table<Vtable>* m, std::pmr::memory_resource*, Arg&& arg) noexcept
+        {
+            if constexpr(std::is_pointer_v<U>)
+            {
+                _ptr = const_cast<void*>(static_cast<const volatile void*>(U(arg)));
+                if(!_ptr)
+                    return;
+            }
+            else if constexpr(is_stateless_v<U> && !std::is_lvalue_reference_v<Arg>)
+                _ptr = &stateless_instance<U>;
+            else
+            {
+                static_assert(std::is_lvalue_reference_v<Arg>, "Interface references can't refer to temporaries.");
+                static_assert(!std::is_const_v<std::remove_reference_t<Arg>> || is_const_vtable<Vtable>::value,
+                              "Interface references can't refer to const objects unless all methods are const.");
+                _ptr = const_cast<void*>(static_cast<const void*>(std::addressof(arg)));
+            }
+            _t = m;
+            _vtable = m->vtable;
+        }
+
+        // Refers to the object of another interface, which must outlive this.
+        constexpr void copy(const void* p, const thunk* t, const Vtable& vtable, std::pmr::memory_resource*) noexcept
+        {
+            _ptr = const_cast<void*>(p);
+            _t = t;
+            _vtable = vtable;
+        }
+        constexpr void move(void* p, const thunk* t, const Vtable& vtable, std::pmr::memory_resource* mr) noexcept
+        {
+            copy(p, t, vtable, mr);
+        }
+        constexpr void copy(const ref_layout& other, std::pmr::memory_resource*) noexcept { *this = other; }
+        constexpr void move(ref_layout& other, std::pmr::memory_resource*) noexcept { *this = other; }
+
+        // Only for uniformity, referred to objects are never shared.
+        constexpr void unshare() noexcept {}
+
+        // Objects aren't owned and can't be released.
+        template<typename C>
+        void* release_ptr(std::pmr::memory_resource*) noexcept
+        {
+            return nullptr;
+        }
+        // Only for uniformity, objects are never released to interface references.
+        constexpr void adopt(void* p, const thunk* t, const Vtable& vtable, std::pmr::memory_resource* mr) noexcept
+        {
+            copy(p, t, vtable, mr);
+        }
+
+        constexpr void* ptr() const noexcept { return _ptr; }
+        constexpr const thunk* type() const noexcept { return _t ? _t->type : nullptr; }
+        constexpr const thunk* object_thunk() const noexcept { return _t; }
+        constexpr std::pmr::memory_resource* resource() const noexcept { return nullptr; }
+        constexpr bool is_inline() const noexcept { return false; }
+        constexpr std::size_t heap_size() const noexcept { return 0; }
+        constexpr const flat_vtable<Vtable>& vtable() const noexcept { return _vtable; }
+
+        template<typename T>
+        target_t<T> get() const noexcept
+        {
+            if constexpr(std::is_pointer_v<T>)
+                return static_cast<T>(_ptr);
+            else
+                return static_cast<T*>(_ptr);
+        }
+
+        friend void swap(ref_layout& x, ref_layout& y) noexcept
+        {
+            std::swap(x._ptr, y._ptr);
+            std::swap(x._t, y._t);
+            std::swap(x._vtable, y._vtable);
+        }
+
+      private:
+        void* _ptr = nullptr;
+        const thunk* _t = nullptr;
+        flat_vtable<Vtable> _vtable = {};
+    };
+
+    // Index of U within Ts, sizeof...(Ts) if not found.
+    template<typename U, typename... Ts>
+    constexpr std::size_t index_of() noexcept
+    {
+        std::size_t k = 0;
+        bool found = ((++k, std::is_same_v<U, Ts>) || ...);
+        return found ? k - 1 : sizeof...(Ts);
+    }
+
+    // Maximum number of types in a sealed interface, set through generate.go -sealed.
+    inline constexpr std::size_t sealed_max = 16;
+
+    // Smallest unsigned type holding 0 to N.
+    template<std::size_t N>
+    using small_index_t = std::conditional_t<N <= UINT8_MAX, std::uint8_t,
+                                             std::conditional_t<N <= UINT16_MAX, std::uint16_t, std::size_t>>;
+
+    // Descriptor of sealed interfaces, one past the index of the stored type within Ts, 0 if empty.
+    // It is the only descriptor of the object, its thunk is looked up by index.
+    template<typename... Ts>
+    struct sealed_index
+    {
+        small_index_t<sizeof...(Ts)> value = 0;
+
+        constexpr explicit operator bool() const noexcept { return value != 0; }
+    };
+
+    template<typename... Ts>
+    constexpr const thunk* thunk_of(sealed_index<Ts...> d) noexcept
+    {
+        constexpr const thunk* thunks[] = {nullptr, get_thunk<Ts, true>()...};
+        return thunks[d.value];
+    }
+    template<typename... Ts>
+    constexpr const thunk* type_of(sealed_index<Ts...> d) noexcept
+    {
+        return thunk_of(d)->type;
+    }
+
+    // Types is void(Ts...), the closed set of types a sealed interface may store.
+    template<typename Types>
+    struct sealed;
+
+    template<typename... Ts>
+    struct sealed<void(Ts...)>
+    {
+        static_assert(sizeof...(Ts) > 0, "Sealed interfaces must have at least one type.");
+        static_assert(sizeof...(Ts) <= sealed_max, "Too many types in sealed interface.");
+
+        // Keeps only the index of the stored type in place of a method table pointer, calls are
+        // dispatched through a switch over the index, special member functions through its thunk.
+        // Method tables aren't kept, hence vtable slots are looked up through dispatch as well.
+        template<typename Vtable>
+        class layout : public basic_storage<sealed_index<Ts...>>
+        {
+            using base = basic_storage<sealed_index<Ts...>>;
+
+          public:
+            static constexpr bool sealed = true;
+
+            using base::copy;
+            using base::move;
+
+            template<typename U, typename... Args>
+            void emplace(const method_table<Vtable>*, std::pmr::memory_resource* mr, Args&&... args)
+            {
+                constexpr auto k = index_of<U, Ts...>();
+                static_assert(k < sizeof...(Ts), "Type isn't one of the sealed types.");
+                base::template emplace<U>(sealed_index<Ts...>{k + 1}, mr, std::forward<Args>(args)...);
+            }
+
+            // Objects erased by other interfaces may not be one of the sealed types.
+            void copy(const void* p, const thunk* t, const Vtable& vtable, std::pmr::memory_resource* mr) = delete;
+            void move(void* p, const thunk* t, const Vtable& vtable, std::pmr::memory_resource* mr) = delete;
+            void adopt(void* p, const thunk* t, const Vtable& vtable, std::pmr::memory_resource* mr) = delete;
+
+            // Calls f with the type_tag of the stored type, which must not be empty.
+            template<typename F>
+            decltype(auto) dispatch(F&& f) const
+            {
+                switch(this->desc().value - 1)
+                {
+                case 1:
+                    if constexpr(1 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<1, std::tuple<Ts...>>>{});
+                case 2:
+                    if constexpr(2 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<2, std::tuple<Ts...>>>{});
+                case 3:
+                    if constexpr(3 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<3, std::tuple<Ts...>>>{});
+                case 4:
+                    if constexpr(4 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<4, std::tuple<Ts...>>>{});
+                case 5:
+                    if constexpr(5 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<5, std::tuple<Ts...>>>{});
+                case 6:
+                    if constexpr(6 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<6, std::tuple<Ts...>>>{});
+                case 7:
+                    if constexpr(7 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<7, std::tuple<Ts...>>>{});
+                case 8:
+                    if constexpr(8 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<8, std::tuple<Ts...>>>{});
+                case 9:
+                    if constexpr(9 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<9, std::tuple<Ts...>>>{});
+                case 10:
+                    if constexpr(10 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<10, std::tuple<Ts...>>>{});
+                case 11:
+                    if constexpr(11 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<11, std::tuple<Ts...>>>{});
+                case 12:
+                    if constexpr(12 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<12, std::tuple<Ts...>>>{});
+                case 13:
+                    if constexpr(13 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<13, std::tuple<Ts...>>>{});
+                case 14:
+                    if constexpr(14 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<14, std::tuple<Ts...>>>{});
+                case 15:
+                    if constexpr(15 < sizeof...(Ts))
+                        return f(type_tag<std::tuple_element_t<15, std::tuple<Ts...>>>{});
+                default:
+                    return f(type_tag<std::tuple_element_t<0, std::tuple<Ts...>>>{});
+                }
+            }
+
+            friend void swap(layout& x, layout& y) noexcept
+            {
+                swap(static_cast<base&>(x), static_cast<base&>(y));
+            }
+        };
+    };
+
+    // Called through a free function so that layouts other than sealed need not have dispatch.
+    template<typename Layout, typename F>
+    decltype(auto) dispatch(const Layout& l, F&& f)
+    {
+        return l.dispatch(std::forward<F>(f));
+    }
+
+    // Slot K of the vtable of l, where Factory<T> erases the method for type T.
+    // Sealed layouts keep no vtable, the slot is the erased method of the stored type.
+    template<std::size_t K, typename Signature, template<typename> typename Factory, typename Layout>
+    constexpr auto get_slot(const Layout& l)
+    {
+        if constexpr(Layout::sealed)
+            return dispatch(l, [](auto tag) { return &erasure_fn<Signature, Factory<typename decltype(tag)::type>>::value; });
+        else
+        {
+            using std::get;
+            return get<K>(l.vtable());
+        }
+    }
+
+    // Calls a method on each interface in [first, last), none of which may be empty.
+    // method maps an interface to its vtable slot, as made by INTERFACE_METHOD.
+    // Arguments are passed as lvalues to every call, results are discarded.
+    template<typename It, typename Method, typename... Args>
+    void for_each_call(It first, It last, Method method, Args&&... args)
+    {
+        for(; first != last; ++first)
+        {
+            auto f = method(*first);
+            // Shared objects are unshared before non-const calls, as by calling the method.
+            if constexpr(is_mutating_call<std::remove_pointer_t<decltype(f)>>::value)
+                unshare_object(*first, interface_tag{});
+            // Coroutine frames are allocated from the resource of each object, as by calling the method.
+            frame_scope<call_return_t<decltype(f)>> scope{fetch_resource(*first, interface_tag{})};
+            ::interface_detail::invoke(f, fetch_ptr(*first, interface_tag{}), args...);
+        }
+    }
+
+    // Memory resource of the object a method returning Ret is bound to, kept only if Ret is a coroutine type
+    // for the frame_scope of its calls.
+    template<typename Ret, bool = is_coroutine_type<Ret>::value>
+    class bound_resource
+    {
+      public:
+        constexpr explicit bound_resource(std::pmr::memory_resource* = nullptr) noexcept {}
+        constexpr std::pmr::memory_resource* resource() const noexcept { return nullptr; }
+    };
+
+    template<typename Ret>
+    class bound_resource<Ret, true>
+    {
+      public:
+        constexpr explicit bound_resource(std::pmr::memory_resource* mr = nullptr) noexcept : _mr{mr} {}
+        constexpr std::pmr::memory_resource* resource() const noexcept { return _mr; }
+
+      private:
+        std::pmr::memory_resource* _mr;
+    };
+
+    // Non-owning callable of a method bound to the object of an interface.
+    // Invalidated the same way as pointers returned by target.
+    template<typename Signature>
+    class bound_method;
+
+    template<typename Ret, typename Obj, typename... Params, bool NoExcept>
+    class bound_method<Ret(Obj*, Params...) noexcept(NoExcept)> : bound_resource<Ret>
+    {
+      public:
+        bound_method() = default;
+        bound_method(Ret (*f)(Obj*, Params...) noexcept(NoExcept), void* p, std::pmr::memory_resource* mr) noexcept
+            : bound_resource<Ret>{mr}, _f{f}, _p{p}
+        {
+        }
+
+        template<typename... Args>
+        Ret operator()(Args&&... args) const
+            noexcept(noexcept(::interface_detail::invoke(_f, _p, std::forward<Args>(args)...)))
+        {
+            frame_scope<Ret> scope{this->resource()};
+            return ::interface_detail::invoke(_f, _p, std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const noexcept { return _f; }
+
+      private:
+        Ret (*_f)(Obj*, Params...) noexcept(NoExcept) = nullptr;
+        void* _p = nullptr;
+    };
+
+    // Binds a method of i, method is made by INTERFACE_METHOD.
+    // Binding an empty interface gives an empty bound_method.
+    // Shared objects are unshared when binding non-const methods.
+    template<typename I, typename Method>
+    auto bind_method(I& i, Method method) -> bound_method<std::remove_pointer_t<decltype(method(i))>>
+    {
+        if(!i)
+            return {};
+        if constexpr(is_mutating_call<std::remove_pointer_t<decltype(method(i))>>::value)
+            unshare_object(i, interface_tag{});
+        return {method(i), fetch_ptr(i, interface_tag{}), fetch_resource(i, interface_tag{})};
+    }
+
+    // Vtable of an interface, the leading void lets each method be emitted with a leading comma.
+    template<typename Void, typename... Fns>
+    using vtable_type = std::tuple<Fns...>;
+
+    // Everything of an interface except its methods and constructors, which Interface adds.
+    // Interface holds _storage of type layout_t, and provides vtable_for<T>, the method_table of T,
+    // and vtable_of(i), the vtable of another interface i looked up by method names.
+    // Interface befriends basic_interface to reach them, and is incomplete until its members are used.
+    template<typename Interface>
+    class basic_interface : public interface_tag
+    {
+        template<typename I>
+        static constexpr auto& storage(I& i) noexcept
+        {
+            return i._storage;
+        }
+
+        // Properties of the layout, for friends which can't access Interface.
+        static constexpr bool owning() noexcept { return Interface::layout_t::owning; }
+        static constexpr bool shared() noexcept { return Interface::layout_t::shared; }
+        static constexpr bool sealed() noexcept { return Interface::layout_t::sealed; }
+
+        // Used in target.
+        // Used in converting from one interface to another to bypass access level.
+        // interface_tag used to avoid namespace pollution, however improbable.
+        friend constexpr auto fetch_ptr(const Interface& i, interface_tag) { return storage(i).ptr(); }
+
+        // Used in converting from one interface to another to bypass access level, copies go through it.
+        // interface_tag used to avoid namespace pollution, however improbable.
+        friend constexpr auto fetch_thunk(const Interface& i, interface_tag) { return storage(i).object_thunk(); }
+
+        // Used in converting from one interface to another, so that copies allocate from the same resource.
+        // interface_tag used to avoid namespace pollution, however improbable.
+        friend constexpr auto fetch_resource(const Interface& i, interface_tag) { return storage(i).resource(); }
+
+        // Used in converting to interface references, which can't refer to objects of temporary interfaces.
+        // interface_tag used to avoid namespace pollution, however improbable.
+        friend constexpr bool owns_object(const Interface*, interface_tag) { return owning(); }
+
+        // Used in interface_vector, which refers to its objects through pointers that sealed interfaces can't hold.
+        // interface_tag used to avoid namespace pollution, however improbable.
+        friend constexpr bool is_sealed(const Interface*, interface_tag) { return sealed(); }
+
+        // Used in bulk calls and bound methods of non-const methods, as called by the methods themselves.
+        // interface_tag used to avoid namespace pollution, however improbable.
+        friend void unshare_object(Interface& i, interface_tag) noexcept(!shared()) { storage(i).unshare(); }
+
+        // Used in converting from one interface to another, so that heap objects are taken over.
+        // Releases the heap object if it is allocated from mr and counted by C, returns null otherwise.
+        // interface_tag used to avoid namespace pollution, however improbable.
+        template<typename C>
+        friend void* release_ptr(Interface& i, std::pmr::memory_resource* mr, type_tag<C>, interface_tag) noexcept
+        {
+            return storage(i).template release_ptr<C>(mr);
+        }
+
+      protected:
+        // Heap objects are allocated from mr, or with new if null.
+        template<typename I>
+        constexpr void construct(I&& i, std::pmr::memory_resource* mr)
+        {
+            if(!i)
+                return;
+
+            // The stored type of a unique interface might not be copyable, interface references never copy it.
+            static_assert(!owning() || std::is_copy_constructible_v<std::decay_t<I>> || !std::is_copy_constructible_v<Interface>,
+                          "Copyable interfaces can't hold objects of unique interfaces.");
+
+            // Interface references to a temporary interface would dangle, references to references don't.
+            static_assert(owning() || std::is_lvalue_reference_v<I> ||
+                          !owns_object(static_cast<std::decay_t<I>*>(nullptr), interface_tag{}),
+                          "Interface references can't refer to objects of temporary interfaces.");
+
+            // Interface references can't refer to const objects unless all methods are const,
+            // constness of references themselves is shallow.
+            static_assert(owning() || !std::is_const_v<std::remove_reference_t<I>> ||
+                          is_const_vtable<typename Interface::vtable_t>::value ||
+                          !owns_object(static_cast<std::decay_t<I>*>(nullptr), interface_tag{}),
+                          "Interface references can't refer to objects of const interfaces unless all methods are const.");
+
+            // References to shared objects would change the other copies, hence are unshared first as by target.
+            if constexpr(!owning() && !std::is_const_v<std::remove_reference_t<I>> &&
+                         owns_object(static_cast<std::decay_t<I>*>(nullptr), interface_tag{}))
+                unshare_object(i, interface_tag{});
+
+            auto p = fetch_ptr(i, interface_tag{});
+            auto t = fetch_thunk(i, interface_tag{});
+
+            // Magic here. Constructs vtable by name at compile time.
+            // This is the reason why we can't use polymorphic classes as in std::function.
+            auto vtable = Interface::vtable_of(i);
+
+            // Other constructor guarantees the two following calls are both valid.
+            // storage decides whether the object goes inline or on the heap.
+            // Deleted for compact and sealed layouts, there is no vtable_for the erased type.
+            // Objects referred to by interface references are copied even from rvalues, they aren't owned.
+            auto& s = storage(self());
+            if constexpr(std::is_lvalue_reference_v<I> || std::is_const_v<I> ||
+                         !owns_object(static_cast<std::decay_t<I>*>(nullptr), interface_tag{}))
+            {
+                static_assert(!owning() || std::is_copy_constructible_v<std::decay_t<I>>, "Unique interfaces can only be moved from.");
+                s.copy(p, t, vtable, mr);
+            }
+            // Heap objects of rvalues are taken over without allocating when possible.
+            // Objects still shared with other interfaces are unshared before moving from them.
+            else if constexpr(owning())
+            {
+                using count_t = typename Interface::layout_t::count_type;
+                if(auto q = release_ptr(i, mr, type_tag<count_t>{}, interface_tag{}))
+                    s.adopt(q, t, vtable, mr);
+                else
+                {
+                    unshare_object(i, interface_tag{});
+                    s.move(fetch_ptr(i, interface_tag{}), t, vtable, mr);
+                }
+            }
+            else
+                s.move(p, t, vtable, mr);
+        }
+
+        // Constructs a U from args.
+        template<typename U, typename... Args>
+        constexpr void construct_object(std::pmr::memory_resource* mr, Args&&... args)
+        {
+            // Copy constructor is deleted along with the layout's for unique interfaces.
+            // Interface references never copy objects.
+            if constexpr(owning())
+            {
+                if constexpr(std::is_copy_constructible_v<Interface>)
+                    static_assert(std::is_constructible_v<U, const U&>, "Value semantics require the type be copy constructible.");
+                else
+                    static_assert(std::is_constructible_v<U, U&&>, "Unique interfaces require the type be move constructible.");
+            }
+
+            // Small objects are constructed in the inline buffer, others on the heap.
+            storage(self()).template emplace<U>(&Interface::template vtable_for<U>, mr, std::forward<Args>(args)...);
+        }
+
+        // Constructs a U from args directly in storage, without a temporary U.
+        template<typename U, typename... Args>
+        void construct_in_place(std::pmr::memory_resource* mr, Args&&... args)
+        {
+            static_assert(owning(), "Interface references can't construct objects.");
+            static_assert(!std::is_pointer_v<U>, "Only objects can be constructed in place, construct from pointers instead.");
+            construct_object<U>(mr, std::forward<Args>(args)...);
+        }
+
+        // Allocator extended construction from t, an interface or any other type.
+        // Heap objects are allocated from mr, which is recorded for copies and destruction.
+        template<typename T>
+        constexpr void construct_any(std::pmr::memory_resource* mr, T&& t)
+        {
+            using U = std::decay_t<T>;
+            if constexpr(std::is_same_v<U, Interface>)
+            {
+                if constexpr(std::is_lvalue_reference_v<T> || std::is_const_v<T>)
+                    storage(self()).copy(storage(t), mr);
+                else
+                    storage(self()).move(storage(t), mr);
+            }
+            else if constexpr(is_interface_v<U>)
+                construct(std::forward<T>(t), mr);
+            else
+                construct_object<U>(mr, std::forward<T>(t));
+        }
+
+      public:
+        // Fetches underlying type if thunk* matches, which serves as RTTI.
+        // Shared objects are copied on mutable access, which may throw.
+        template<typename T>
+        friend target_t<T> target(Interface&& i) noexcept(!shared())
+        {
+            if(storage(i).type() == get_thunk<T>())
+                return storage(i).template get<T>();
+            else
+                return nullptr;
+        }
+        template<typename T>
+        friend target_t<T> target(Interface& i) noexcept(!shared())
+        {
+            if(storage(i).type() == get_thunk<T>())
+                return storage(i).template get<T>();
+            else
+                return nullptr;
+        }
+        template<typename T>
+        friend const_target_t<T> target(const Interface& i) noexcept
+        {
+            if(storage(i).type() == get_thunk<T>())
+                return storage(i).template get<T>();
+            else
+                return nullptr;
+        }
+
+        // Constructs a T from args in place of the stored object, which is destroyed first and must not be
+        // referred to by args. An unshared heap buffer of the same size and alignment is reused,
+        // other heap objects are allocated from the resource of the stored object.
+        // The interface is left empty if construction throws.
+        template<typename T, typename... Args>
+        std::decay_t<T>& emplace(Args&&... args)
+        {
+            using U = std::decay_t<T>;
+            auto& s = storage(self());
+            construct_in_place<U>(s.resource(), std::forward<Args>(args)...);
+            return *static_cast<U*>(s.ptr());
+        }
+
+        // Bytes of heap memory held by i, including the count of shared objects, which each sharer reports.
+        // 0 for inline objects, pointers, interface references and empty interfaces.
+        friend std::size_t storage_size(const Interface& i) noexcept { return storage(i).heap_size(); }
+
+        // Returns true if the object of i is stored in its inline buffer.
+        friend bool is_inline(const Interface& i) noexcept { return storage(i).is_inline(); }
+
+        // Returns true if there is an underlying object.
+        constexpr explicit operator bool() const noexcept { return storage(self()).ptr(); }
+
+        // Returns true iff both interfaces are empty or both references the same object.
+        // Distinct owning interfaces only share objects when shared, so compare equal to themselves.
+        template<typename I, std::enable_if_t<std::is_same_v<Interface, std::decay_t<I>>, bool> = false>
+        constexpr bool operator==(I&& rhs) const noexcept
+        {
+            return storage(self()).ptr() == storage(rhs).ptr();
+        }
+        template<typename I, std::enable_if_t<std::is_same_v<Interface, std::decay_t<I>>, bool> = false>
+        constexpr bool operator!=(I&& rhs) const noexcept { return !(*this == rhs); }
+
+        // Orders interface references by the address of their objects, consistent with operator== and interface_hash.
+        // Owning interfaces aren't ordered, their objects are copied along with them and inline ones move with them,
+        // so that a key stored by a container wouldn't keep the order it was inserted by.
+        template<typename I, std::enable_if_t<std::is_same_v<Interface, std::decay_t<I>> &&
+                                              !basic_interface<std::decay_t<I>>::owning(), bool> = false>
+        bool operator<(I&& rhs) const noexcept
+        {
+            return std::less<const void*>{}(storage(self()).ptr(), storage(rhs).ptr());
+        }
+
+        // Compares the objects of x and y with operator== of the stored type when both are of the same type,
+        // provided INTERFACE_VALUE_EQUALITY is defined and it is equality comparable, as operator== otherwise.
+        friend bool equal_values(const Interface& x, const Interface& y)
+        {
+            auto& l = storage(x);
+            auto& r = storage(y);
+            if(l.ptr() == r.ptr())
+                return true;
+            if(!l.ptr() || !r.ptr() || l.type() != r.type() || !l.type()->equal)
+                return false;
+            return l.type()->equal(l.ptr(), r.ptr());
+        }
+
+        friend void swap(Interface& x, Interface& y) noexcept
+        {
+            using std::swap;
+            swap(storage(x), storage(y));
+        }
+
+        // Converts to other interfaces by referring to the object of i instead of copying it.
+        // Shared objects are unshared first as by target, since the borrowing interface may mutate it.
+        friend borrowed<Interface> borrow(Interface& i) noexcept(!shared())
+        {
+            unshare_object(i, interface_tag{});
+            return borrowed<Interface>{i};
+        }
+
+      private:
+        constexpr Interface& self() noexcept { return static_cast<Interface&>(*this); }
+        constexpr const Interface& self() const noexcept { return static_cast<const Interface&>(*this); }
+    };
+}
+
+// For ADL purposes.
+template<typename T, typename I>
+void target(I&&, ::interface_detail::interface_tag);
+
+// Hashes interface references by the address of their objects, consistent with operator==.
+// Owning interfaces aren't hashed, for the same reason they aren't ordered.
+struct interface_hash
+{
+    template<typename I, std::enable_if_t<::interface_detail::is_interface_v<I>, bool> = false>
+    std::size_t operator()(const I& i) const noexcept
+    {
+        static_assert(!owns_object(static_cast<const I*>(nullptr), ::interface_detail::interface_tag{}),
+                      "Only interface references can be hashed, owning interfaces copy and move their objects.");
+        return std::hash<const void*>{}(fetch_ptr(i, ::interface_detail::interface_tag{}));
+    }
+};
+
+// Base of promise types of coroutines returned by interface methods.
+// Frames are allocated from the memory resource of the called interface's object,
+// or with new if there is none, and record the resource in front of the frame for deallocation.
+struct interface_frame_allocator
+{
+    static void* operator new(std::size_t size)
+    {
+        auto mr = ::interface_detail::frame_resource;
+        auto buf = ::interface_detail::allocate(frame_header + size, alignof(std::max_align_t), mr);
+        ::new (buf.get()) std::pmr::memory_resource*{mr};
+        return buf.release() + frame_header;
+    }
+
+    static void operator delete(void* p, std::size_t size) noexcept
+    {
+        auto buf = static_cast<std::byte*>(p) - frame_header;
+        auto mr = *std::launder(reinterpret_cast<std::pmr::memory_resource**>(buf));
+        auto align = ::interface_detail::heap_align(alignof(std::max_align_t));
+        ::interface_detail::deallocator{mr, frame_header + size, align}(buf);
+    }
+
+  private:
+    // Keeps frames aligned as new would.
+    static constexpr std::size_t frame_header = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+};
+}
+
+// GCC 12 doesn't emit the thunk of pointers in importers, this odr-use emits it with the module.
+namespace interface_detail
+{
+    const thunk* pointer_thunk() noexcept { return get_thunk<void*>(); }
+}
@@ -0,0 +1,358 @@
+// DO NOT modify, this is a machine generated file.
+// DO NOT include directly, this is a implementation file.
+// The macros of interface, for use with the module. See impl/README for details.
+
+// For creating anonymous variables.
+#define INTERFACE_CONCAT_DIRECT(x, y) x##y
+#define INTERFACE_CONCAT(x, y) INTERFACE_CONCAT_DIRECT(x, y)
+#define INTERFACE_APPEND_LINE(x) INTERFACE_CONCAT(x, __LINE__)
+
+#ifdef INTERFACE_FOR_EXPOSITION_ONLY
+// The following is used only as documentation to the implementation of interface.
+// SIGNATURE0 and METHOD_NAME0 are the parameters passed in by the user, LAYOUT is eg object_layout.
+// Only the methods are expanded per interface, INTERFACE_FOR_EACH_N applies a macro to each of N methods.
+// Its first argument K counts down from N, the method's index in the vtable is N - K.
+
+// Inherits from interface_tag through basic_interface for type traits is_interface.
+// basic_interface holds everything not depending on the methods, and is shared across arities.
+class INTERFACE_APPEND_LINE(interface__)
+    : public ::interface_detail::basic_interface<INTERFACE_APPEND_LINE(interface__)>
+{
+    // Alias for both readability and for recursively defined functions:
+    // user may provide a function signature including interface.
+    using interface = INTERFACE_APPEND_LINE(interface__);
+    using vtable_t = ::interface_detail::vtable_type<void, typename ::interface_detail::erasure_fn<SIGNATURE0>::type*>;
+    using layout_t = LAYOUT<vtable_t>;
+    friend class ::interface_detail::basic_interface<interface>;
+
+    friend constexpr auto get_##METHOD_NAME0(const interface& i, ::interface_detail::interface_tag)
+    {
+        return ::interface_detail::get_slot<::std::tuple_size_v<vtable_t> - 1, SIGNATURE0, METHOD_NAME0##_1_factory>(i._storage);
+    }
+
+    // Factory for type erased method call
+    // Suffix used to avoid name collisions.
+    template <typename T>
+    struct METHOD_NAME0##_1_factory
+    {
+        template <typename... Args>
+        static decltype(auto) call(void* p, Args&&... args)
+            noexcept(noexcept(::interface_detail::as_object<T>(p).METHOD_NAME0(::std::forward<Args>(args)...)))
+        {
+            return ::interface_detail::as_object<T>(p).METHOD_NAME0(::std::forward<Args>(args)...);
+        }
+        template <typename... Args>
+        static decltype(auto) call_const(const void* p, Args&&... args)
+            noexcept(noexcept(::interface_detail::as_const_object<T>(p).METHOD_NAME0(::std::forward<Args>(args)...)))
+        {
+            return ::interface_detail::as_const_object<T>(p).METHOD_NAME0(::std::forward<Args>(args)...);
+        }
+    };
+
+    // Methods of T, constructed by name at compile time.
+    // erasure_fn is a unified interface to the method.
+    // compact_layout points to it, object_layout copies the vtable and points to it for the thunk.
+    // The copy is left out for unique interfaces, so that types that only declare one may be stored.
+    template<typename T>
+    inline static constexpr ::interface_detail::method_table<vtable_t> vtable_for = {
+        *::interface_detail::get_thunk<T, ::std::is_copy_constructible_v<layout_t>>(),
+        {
+            ::interface_detail::erasure_fn<SIGNATURE0, METHOD_NAME0##_1_factory<T>>::value,
+        }
+    };
+
+    // Magic here. Looks up the methods of another interface by name at compile time.
+    // This is the reason why we can't use polymorphic classes as in std::function.
+    template<typename I>
+    static constexpr vtable_t vtable_of(const I& i)
+    {
+        return {
+            get_##METHOD_NAME0(i, ::interface_detail::interface_tag{}),
+        };
+    }
+
+  public:
+    // Copy and move are defaulted, the copy constructor is deleted for unique interfaces.
+    // The other constructors forward to basic_interface, as do target, comparisons, swap and borrow.
+    INTERFACE_APPEND_LINE(interface__)() = default;
+    INTERFACE_APPEND_LINE(interface__)(interface&&) = default;
+    INTERFACE_APPEND_LINE(interface__)(const interface&) = default;
+
+    // Converts from another interface, looking up the methods by name.
+    template<typename I, ::std::enable_if_t<::interface_detail::is_interface_v<::std::decay_t<I>> &&
+                                            !::std::is_same_v<::std::decay_t<I>, interface>, bool> = false>
+    constexpr INTERFACE_APPEND_LINE(interface__)(I&& i)
+    {
+        this->construct(::std::forward<I>(i), fetch_resource(i, ::interface_detail::interface_tag{}));
+    }
+
+    // Stores an object, or refers to it through a pointer.
+    template<typename T, ::std::enable_if_t<!::interface_detail::is_interface_v<::std::decay_t<T>> &&
+                                            !::interface_detail::is_in_place_type_v<::std::decay_t<T>>, bool> = false>
+    constexpr INTERFACE_APPEND_LINE(interface__)(T&& t)
+    {
+        this->template construct_object<::std::decay_t<T>>(nullptr, ::std::forward<T>(t));
+    }
+
+    // Constructs a T from args directly in storage, as emplace.
+    template<typename T, typename... Args>
+    explicit INTERFACE_APPEND_LINE(interface__)(::std::in_place_type_t<T>, Args&&... args)
+    {
+        this->template construct_in_place<::std::decay_t<T>>(nullptr, ::std::forward<Args>(args)...);
+    }
+
+    // Allocates from mr whatever doesn't fit inline.
+    template<typename T, ::std::enable_if_t<!::interface_detail::is_in_place_type_v<::std::decay_t<T>>, bool> = false>
+    constexpr INTERFACE_APPEND_LINE(interface__)(::std::allocator_arg_t, ::std::pmr::memory_resource* mr, T&& t)
+    {
+        this->construct_any(mr, ::std::forward<T>(t));
+    }
+
+    // Constructs a T from args directly in storage, allocating from mr if it doesn't fit inline.
+    template<typename T, typename... Args>
+    explicit INTERFACE_APPEND_LINE(interface__)(::std::allocator_arg_t, ::std::pmr::memory_resource* mr,
+                                                ::std::in_place_type_t<T>, Args&&... args)
+    {
+        this->template construct_in_place<::std::decay_t<T>>(mr, ::std::forward<Args>(args)...);
+    }
+
+    interface& operator=(const interface&) = default;
+    interface& operator=(interface&&) = default;
+
+    // noexcept signatures give noexcept methods, except non-const ones of shared interfaces.
+    template <typename... Args>
+    decltype(auto) METHOD_NAME0(Args&&... args) noexcept(::interface_detail::is_nothrow_method_v<layout_t, SIGNATURE0, Args...>)
+    {
+        // Hooks of INTERFACE_INSTRUMENT are constructed first, see INTERFACE_INSTRUMENT_CALL.
+        INTERFACE_INSTRUMENT_CALL(1, METHOD_NAME0)
+
+        // Copy on write, shared objects are copied before calling non-const methods.
+        if constexpr(!::interface_detail::is_const_signature_v<SIGNATURE0, Args...>)
+            _storage.unshare();
+
+        // Coroutine frames made by the call are allocated from the resource of the held object.
+        ::interface_detail::frame_scope<typename ::interface_detail::erasure_fn<SIGNATURE0>::return_type> scope{_storage.resource()};
+
+        // Sealed interfaces switch over the stored type and call the factory directly,
+        // which may be inlined.
+        if constexpr(layout_t::sealed)
+            return ::interface_detail::dispatch(_storage, [&](auto tag) -> decltype(auto) {
+                using T = typename decltype(tag)::type;
+                return ::interface_detail::invoke(&::interface_detail::erasure_fn<SIGNATURE0, METHOD_NAME0##_1_factory<T>>::value,
+                                                  _storage.ptr(), ::std::forward<Args>(args)...);
+            });
+        // Dispatches to type erased method call.
+        else
+            return ::interface_detail::invoke(get_##METHOD_NAME0(*this, ::interface_detail::interface_tag{}),
+                                              _storage.ptr(), ::std::forward<Args>(args)...);
+    }
+
+    // Const signatures may be called on const interfaces.
+    // The type erased call takes const void*, hence can't mutate the object.
+    // Constness of interface references is shallow, any method may be called on them.
+    template <typename... Args>
+    decltype(auto) METHOD_NAME0(Args&&... args) const noexcept(::interface_detail::is_nothrow_method_v<layout_t, SIGNATURE0, Args...>)
+    {
+        static_assert(!layout_t::owning || ::interface_detail::is_const_signature_v<SIGNATURE0, Args...>,
+                      "Only const methods can be called on const interfaces.");
+        return const_cast<interface&>(*this).METHOD_NAME0(::std::forward<Args>(args)...);
+    }
+
+  private:
+    // Declared last so that the layout is that of the storage alone.
+    layout_t _storage;
+}
+
+#endif // INTERFACE_FOR_EXPOSITION_ONLY
+
+// The following is the actual implementaion for interface.
+
+// Applies OP(K, SIGNATURE, METHOD_NAME) to each method, K counts down from the number of methods.
+#define INTERFACE_FOR_EACH_1(OP, SIGNATURE, METHOD_NAME) OP(1, SIGNATURE, METHOD_NAME)
+#define INTERFACE_FOR_EACH_2(OP, SIGNATURE, METHOD_NAME, ...) OP(2, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_1(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_3(OP, SIGNATURE, METHOD_NAME, ...) OP(3, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_2(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_4(OP, SIGNATURE, METHOD_NAME, ...) OP(4, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_3(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_5(OP, SIGNATURE, METHOD_NAME, ...) OP(5, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_4(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_6(OP, SIGNATURE, METHOD_NAME, ...) OP(6, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_5(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_7(OP, SIGNATURE, METHOD_NAME, ...) OP(7, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_6(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_8(OP, SIGNATURE, METHOD_NAME, ...) OP(8, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_7(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_9(OP, SIGNATURE, METHOD_NAME, ...) OP(9, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_8(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_10(OP, SIGNATURE, METHOD_NAME, ...) OP(10, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_9(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_11(OP, SIGNATURE, METHOD_NAME, ...) OP(11, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_10(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_12(OP, SIGNATURE, METHOD_NAME, ...) OP(12, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_11(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_13(OP, SIGNATURE, METHOD_NAME, ...) OP(13, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_12(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_14(OP, SIGNATURE, METHOD_NAME, ...) OP(14, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_13(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_15(OP, SIGNATURE, METHOD_NAME, ...) OP(15, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_14(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_16(OP, SIGNATURE, METHOD_NAME, ...) OP(16, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_15(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_17(OP, SIGNATURE, METHOD_NAME, ...) OP(17, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_16(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_18(OP, SIGNATURE, METHOD_NAME, ...) OP(18, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_17(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_19(OP, SIGNATURE, METHOD_NAME, ...) OP(19, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_18(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_20(OP, SIGNATURE, METHOD_NAME, ...) OP(20, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_19(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_21(OP, SIGNATURE, METHOD_NAME, ...) OP(21, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_20(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_22(OP, SIGNATURE, METHOD_NAME, ...) OP(22, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_21(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_23(OP, SIGNATURE, METHOD_NAME, ...) OP(23, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_22(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_24(OP, SIGNATURE, METHOD_NAME, ...) OP(24, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_23(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_25(OP, SIGNATURE, METHOD_NAME, ...) OP(25, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_24(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_26(OP, SIGNATURE, METHOD_NAME, ...) OP(26, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_25(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_27(OP, SIGNATURE, METHOD_NAME, ...) OP(27, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_26(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_28(OP, SIGNATURE, METHOD_NAME, ...) OP(28, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_27(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_29(OP, SIGNATURE, METHOD_NAME, ...) OP(29, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_28(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_30(OP, SIGNATURE, METHOD_NAME, ...) OP(30, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_29(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_31(OP, SIGNATURE, METHOD_NAME, ...) OP(31, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_30(OP, __VA_ARGS__)
+#define INTERFACE_FOR_EACH_32(OP, SIGNATURE, METHOD_NAME, ...) OP(32, SIGNATURE, METHOD_NAME) INTERFACE_FOR_EACH_31(OP, __VA_ARGS__)
+
+
+
+// Per method members of an interface, applied through INTERFACE_FOR_EACH_N.
+#define INTERFACE_VTABLE_SLOT(K, SIGNATURE, METHOD_NAME) , typename ::interface_detail::erasure_fn<SIGNATURE>::type*
+#define INTERFACE_VTABLE_ENTRY(K, SIGNATURE, METHOD_NAME)\
+::interface_detail::erasure_fn<SIGNATURE, METHOD_NAME##_##K##_factory<T__>>::value,
+#define INTERFACE_VTABLE_LOOKUP(K, SIGNATURE, METHOD_NAME) get_##METHOD_NAME(i, ::interface_detail::interface_tag{}),
+#define INTERFACE_DECLARE_FACTORY(K, SIGNATURE, METHOD_NAME)\
+    friend constexpr auto get_##METHOD_NAME(const interface& i, ::interface_detail::interface_tag)\
+    {\
+        return ::interface_detail::get_slot<::std::tuple_size_v<vtable_t> - K, SIGNATURE, METHOD_NAME##_##K##_factory>(i._storage);\
+    }\
+\
+    template<typename T__>\
+    struct METHOD_NAME##_##K##_factory\
+    {\
+        template<typename... Args__>\
+        static decltype(auto) call(void* p, Args__&&... as)\
+            noexcept(noexcept(::interface_detail::as_object<T__>(p).METHOD_NAME(::std::forward<Args__>(as)...)))\
+        {\
+            return ::interface_detail::as_object<T__>(p).METHOD_NAME(::std::forward<Args__>(as)...);\
+        }\
+        template<typename... Args__>\
+        static decltype(auto) call_const(const void* p, Args__&&... as)\
+            noexcept(noexcept(::interface_detail::as_const_object<T__>(p).METHOD_NAME(::std::forward<Args__>(as)...)))\
+        {\
+            return ::interface_detail::as_const_object<T__>(p).METHOD_NAME(::std::forward<Args__>(as)...);\
+        }\
+    };
+
+// With INTERFACE_INSTRUMENT defined as a class template Hook, each call constructs a
+// Hook<interface> from the method's name, its index in the vtable and the thunk of the stored type,
+// which is destroyed once the call returns. Calls aren't instrumented otherwise.
+// Must be defined consistently across translation units.
+#ifdef INTERFACE_INSTRUMENT
+#define INTERFACE_INSTRUMENT_CALL(K, METHOD_NAME)\
+        INTERFACE_INSTRUMENT<interface> instrument__{#METHOD_NAME, ::std::tuple_size_v<vtable_t> - K, _storage.type()};
+#else
+#define INTERFACE_INSTRUMENT_CALL(K, METHOD_NAME)
+#endif // INTERFACE_INSTRUMENT
+
+#define INTERFACE_DECLARE_METHOD(K, SIGNATURE, METHOD_NAME)\
+    template<typename... Args__>\
+    decltype(auto) METHOD_NAME(Args__&&... as) noexcept(::interface_detail::is_nothrow_method_v<layout_t, SIGNATURE, Args__...>)\
+    {\
+        INTERFACE_INSTRUMENT_CALL(K, METHOD_NAME)\
+        if constexpr(!::interface_detail::is_const_signature_v<SIGNATURE, Args__...>)\
+            _storage.unshare();\
+        ::interface_detail::frame_scope<typename ::interface_detail::erasure_fn<SIGNATURE>::return_type> scope__{_storage.resource()};\
+        if constexpr(layout_t::sealed)\
+            return ::interface_detail::dispatch(_storage, [&](auto tag) -> decltype(auto) {\
+                using T__ = typename decltype(tag)::type;\
+                return ::interface_detail::invoke(&::interface_detail::erasure_fn<SIGNATURE, METHOD_NAME##_##K##_factory<T__>>::value,\
+                                                  _storage.ptr(), ::std::forward<Args__>(as)...);\
+            });\
+        else\
+            return ::interface_detail::invoke(get_##METHOD_NAME(*this, ::interface_detail::interface_tag{}), _storage.ptr(), ::std::forward<Args__>(as)...);\
+    }\
+    template<typename... Args__>\
+    decltype(auto) METHOD_NAME(Args__&&... as) const noexcept(::interface_detail::is_nothrow_method_v<layout_t, SIGNATURE, Args__...>)\
+    {\
+        static_assert(!layout_t::owning || ::interface_detail::is_const_signature_v<SIGNATURE, Args__...>,\
+                      "Only const methods can be called on const interfaces.");\
+        return const_cast<interface&>(*this).METHOD_NAME(::std::forward<Args__>(as)...);\
+    }
+
+// FOR_EACH is INTERFACE_FOR_EACH_N for N methods.
+#define INTERFACE_CLASS(LAYOUT, FOR_EACH, ...)\
+class INTERFACE_APPEND_LINE(interface__) : public ::interface_detail::basic_interface<INTERFACE_APPEND_LINE(interface__)>\
+{\
+    using interface = INTERFACE_APPEND_LINE(interface__);\
+    using vtable_t = ::interface_detail::vtable_type<void FOR_EACH(INTERFACE_VTABLE_SLOT, __VA_ARGS__)>;\
+    using layout_t = LAYOUT<vtable_t>;\
+    friend class ::interface_detail::basic_interface<interface>;\
+\
+    FOR_EACH(INTERFACE_DECLARE_FACTORY, __VA_ARGS__)\
+\
+    template<typename T__>\
+    inline static constexpr ::interface_detail::method_table<vtable_t> vtable_for = {\
+        *::interface_detail::get_thunk<T__, ::std::is_copy_constructible_v<layout_t>>(),\
+        {FOR_EACH(INTERFACE_VTABLE_ENTRY, __VA_ARGS__)}\
+    };\
+\
+    template<typename I__>\
+    static constexpr vtable_t vtable_of(const I__& i)\
+    {\
+        return {FOR_EACH(INTERFACE_VTABLE_LOOKUP, __VA_ARGS__)};\
+    }\
+\
+public:\
+    INTERFACE_APPEND_LINE(interface__)() = default;\
+    INTERFACE_APPEND_LINE(interface__)(interface&&) = default;\
+    INTERFACE_APPEND_LINE(interface__)(const interface&) = default;\
+    template<typename I__, ::std::enable_if_t<::interface_detail::is_interface_v<::std::decay_t<I__>> &&\
+                                              !::std::is_same_v<::std::decay_t<I__>, interface>, bool> = false>\
+    constexpr INTERFACE_APPEND_LINE(interface__)(I__&& i)\
+    {\
+        this->construct(::std::forward<I__>(i), fetch_resource(i, ::interface_detail::interface_tag{}));\
+    }\
+    template<typename T__, ::std::enable_if_t<!::interface_detail::is_interface_v<::std::decay_t<T__>> &&\
+                                              !::interface_detail::is_in_place_type_v<::std::decay_t<T__>>, bool> = false>\
+    constexpr INTERFACE_APPEND_LINE(interface__)(T__&& t)\
+    {\
+        this->template construct_object<::std::decay_t<T__>>(nullptr, ::std::forward<T__>(t));\
+    }\
+    template<typename T__, typename... Args__>\
+    explicit INTERFACE_APPEND_LINE(interface__)(::std::in_place_type_t<T__>, Args__&&... args)\
+    {\
+        this->template construct_in_place<::std::decay_t<T__>>(nullptr, ::std::forward<Args__>(args)...);\
+    }\
+    template<typename T__, ::std::enable_if_t<!::interface_detail::is_in_place_type_v<::std::decay_t<T__>>, bool> = false>\
+    constexpr INTERFACE_APPEND_LINE(interface__)(::std::allocator_arg_t, ::std::pmr::memory_resource* mr, T__&& t)\
+    {\
+        this->construct_any(mr, ::std::forward<T__>(t));\
+    }\
+    template<typename T__, typename... Args__>\
+    explicit INTERFACE_APPEND_LINE(interface__)(::std::allocator_arg_t, ::std::pmr::memory_resource* mr,\
+                                                ::std::in_place_type_t<T__>, Args__&&... args)\
+    {\
+        this->template construct_in_place<::std::decay_t<T__>>(mr, ::std::forward<Args__>(args)...);\
+    }\
+\
+    interface& operator=(const interface&) = default;\
+    interface& operator=(interface&&) = default;\
+\
+    FOR_EACH(INTERFACE_DECLARE_METHOD, __VA_ARGS__)\
+\
+private:\
+    layout_t _storage;\
+}
+
+// Overloaded macros through __VA_ARGS__ hacking.
+// Selects implementation by argument count.
+#define GET_INTERFACE_FROM(_32a, _32b, _31a, _31b, _30a, _30b, _29a, _29b, _28a, _28b, _27a, _27b, _26a, _26b, _25a, _25b, _24a, _24b, _23a, _23b, _22a, _22b, _21a, _21b, _20a, _20b, _19a, _19b, _18a, _18b, _17a, _17b, _16a, _16b, _15a, _15b, _14a, _14b, _13a, _13b, _12a, _12b, _11a, _11b, _10a, _10b, _9a, _9b, _8a, _8b, _7a, _7b, _6a, _6b, _5a, _5b, _4a, _4b, _3a, _3b, _2a, _2b, _1a, _1b, x, ...) x
+#define INTERFACE_WITH_LAYOUT(LAYOUT, ...)\
+INTERFACE_CLASS(LAYOUT, GET_INTERFACE_FROM(__VA_ARGS__, INTERFACE_FOR_EACH_32, _32, INTERFACE_FOR_EACH_31, _31, INTERFACE_FOR_EACH_30, _30, INTERFACE_FOR_EACH_29, _29, INTERFACE_FOR_EACH_28, _28, INTERFACE_FOR_EACH_27, _27, INTERFACE_FOR_EACH_26, _26, INTERFACE_FOR_EACH_25, _25, INTERFACE_FOR_EACH_24, _24, INTERFACE_FOR_EACH_23, _23, INTERFACE_FOR_EACH_22, _22, INTERFACE_FOR_EACH_21, _21, INTERFACE_FOR_EACH_20, _20, INTERFACE_FOR_EACH_19, _19, INTERFACE_FOR_EACH_18, _18, INTERFACE_FOR_EACH_17, _17, INTERFACE_FOR_EACH_16, _16, INTERFACE_FOR_EACH_15, _15, INTERFACE_FOR_EACH_14, _14, INTERFACE_FOR_EACH_13, _13, INTERFACE_FOR_EACH_12, _12, INTERFACE_FOR_EACH_11, _11, INTERFACE_FOR_EACH_10, _10, INTERFACE_FOR_EACH_9, _9, INTERFACE_FOR_EACH_8, _8, INTERFACE_FOR_EACH_7, _7, INTERFACE_FOR_EACH_6, _6, INTERFACE_FOR_EACH_5, _5, INTERFACE_FOR_EACH_4, _4, INTERFACE_FOR_EACH_3, _3, INTERFACE_FOR_EACH_2, _2, INTERFACE_FOR_EACH_1, _1), __VA_ARGS__)
+
+#define INTERFACE(...) INTERFACE_WITH_LAYOUT(::interface_detail::object_layout, __VA_ARGS__)
+#define INTERFACE_COMPACT(...) INTERFACE_WITH_LAYOUT(::interface_detail::compact_layout, __VA_ARGS__)
+#define UNIQUE_INTERFACE(...) INTERFACE_WITH_LAYOUT(::interface_detail::unique_layout, __VA_ARGS__)
+#define SHARED_INTERFACE(...) INTERFACE_WITH_LAYOUT(::interface_detail::shared_layout, __VA_ARGS__)
+#define LOCAL_SHARED_INTERFACE(...) INTERFACE_WITH_LAYOUT(::interface_detail::local_shared_layout, __VA_ARGS__)
+#define INTERFACE_REF(...) INTERFACE_WITH_LAYOUT(::interface_detail::ref_layout, __VA_ARGS__)
+
+// TYPES is a parenthesized list of the types that may be stored.
+#define SEALED_INTERFACE(TYPES, ...)\
+INTERFACE_WITH_LAYOUT(::interface_detail::sealed<void TYPES>::template layout, __VA_ARGS__)
+
+// Selects the vtable slot of a method by name, for use with interface_detail::for_each_call.
+#define INTERFACE_METHOD(METHOD_NAME)\
+[](const auto& i__) { return get_##METHOD_NAME(i__, ::interface_detail::interface_tag{}); }
+
+// Binds a method of an interface lvalue, giving an interface_detail::bound_method.
+#define INTERFACE_BIND(i, METHOD_NAME) ::interface_detail::bind_method(i, INTERFACE_METHOD(METHOD_NAME))
+
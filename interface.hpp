@@ -5,9 +5,16 @@
 #error "Requires C++17"
 #endif // __cplusplus
 
+#include<atomic>
+#include<functional>
 #include<memory>
+#include<memory_resource>
+#include<new>
+#include<tuple>
 #include<type_traits>
+#include<utility>
 #include<cstddef>
+#include<cstring>
 
 #include "impl/interface.hpp"
 
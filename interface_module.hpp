@@ -0,0 +1,20 @@
+#ifndef INTERFACE_MODULE_HPP_INCLUDED
+#define INTERFACE_MODULE_HPP_INCLUDED
+
+#if __cplusplus < 202002L
+#error "Requires C++20"
+#endif // __cplusplus
+
+// As interface.hpp, with interface_detail imported from the module built from impl/interface.cppm.
+// The macros name these directly, which aren't visible through the module.
+#include<memory>
+#include<memory_resource>
+#include<tuple>
+#include<type_traits>
+#include<utility>
+
+import interface;
+
+#include "impl/interface_macros.hpp"
+
+#endif // INTERFACE_MODULE_HPP_INCLUDED
@@ -0,0 +1,220 @@
+#ifndef INTERFACE_VECTOR_HPP_INCLUDED
+#define INTERFACE_VECTOR_HPP_INCLUDED
+
+#include<memory>
+#include<type_traits>
+#include<utility>
+#include<vector>
+#include<cstddef>
+
+#include "interface.hpp"
+
+namespace interface_detail
+{
+    // Type erased operations on the std::vector<T> of a segment.
+    // clone is null for unique interfaces, whose segments are never copied.
+    template<typename I>
+    struct segment_ops
+    {
+        void* (*clone)(const void* v) = nullptr;
+        void (*destroy)(void* v) noexcept = nullptr;
+        void* (*data)(void* v) noexcept = nullptr;
+        std::size_t (*size)(const void* v) noexcept = nullptr;
+        void (*clear)(void* v) noexcept = nullptr;
+        I (*at)(void* v, std::size_t k) noexcept = nullptr; // Interface referring to the k-th object.
+        std::size_t stride = 0;
+    };
+
+    template<typename I, typename T>
+    struct segment_ops_storage
+    {
+        inline static constexpr segment_ops<I> ops = {
+            [](const void* v) -> void* {
+                if constexpr(std::is_copy_constructible_v<I>)
+                    return new std::vector<T>(*static_cast<const std::vector<T>*>(v));
+                else
+                    return nullptr;
+            },
+            [](void* v) noexcept {
+                delete static_cast<std::vector<T>*>(v);
+            },
+            [](void* v) noexcept -> void* {
+                return static_cast<std::vector<T>*>(v)->data();
+            },
+            [](const void* v) noexcept {
+                return static_cast<const std::vector<T>*>(v)->size();
+            },
+            [](void* v) noexcept {
+                static_cast<std::vector<T>*>(v)->clear();
+            },
+            [](void* v, std::size_t k) noexcept {
+                return I(&(*static_cast<std::vector<T>*>(v))[k]);
+            },
+            sizeof(T)
+        };
+    };
+
+    // Owns the contiguous std::vector<T> of all objects of a stored type T.
+    template<typename I>
+    class segment
+    {
+      public:
+        template<typename T>
+        explicit segment(std::in_place_type_t<T>)
+            : _type{get_thunk<T>()}, _ops{&segment_ops_storage<I, T>::ops}, _v{new std::vector<T>}
+        {
+        }
+        segment(const segment& other) : _type{other._type}, _ops{other._ops}, _v{other._ops->clone(other._v)} {}
+        segment(segment&& other) noexcept : _type{other._type}, _ops{other._ops}, _v{std::exchange(other._v, nullptr)} {}
+        ~segment()
+        {
+            if(_v)
+                _ops->destroy(_v);
+        }
+
+        segment& operator=(segment other) noexcept
+        {
+            std::swap(_type, other._type);
+            std::swap(_ops, other._ops);
+            std::swap(_v, other._v);
+            return *this;
+        }
+
+        const thunk* type() const noexcept { return _type; }
+        std::size_t size() const noexcept { return _ops->size(_v); }
+        void clear() noexcept { _ops->clear(_v); }
+
+        template<typename T>
+        std::vector<T>& objects() noexcept
+        {
+            return *static_cast<std::vector<T>*>(_v);
+        }
+
+        template<typename F>
+        void for_each(F& f)
+        {
+            for(std::size_t k = 0, n = size(); k < n; ++k)
+                f(_ops->at(_v, k));
+        }
+
+        // The method is resolved once for the whole segment.
+        template<typename Method, typename... Args>
+        void for_each_call(Method& method, Args&... args)
+        {
+            auto n = size();
+            if(!n)
+                return;
+            auto f = method(_ops->at(_v, 0));
+            auto p = static_cast<std::byte*>(_ops->data(_v));
+            // Objects have no memory resource, frames of coroutines they return are allocated with new.
+            frame_scope<call_return_t<decltype(f)>> scope{nullptr};
+            for(std::size_t k = 0; k < n; ++k, p += _ops->stride)
+                ::interface_detail::invoke(f, static_cast<void*>(p), args...);
+        }
+
+      private:
+        const thunk* _type;
+        const segment_ops<I>* _ops;
+        void* _v;
+    };
+
+    // Segments of an interface_vector, copied into a temporary on assignment so that
+    // a throwing copy leaves them unchanged.
+    template<typename I>
+    class segment_list : public std::vector<segment<I>>
+    {
+      public:
+        segment_list() = default;
+        segment_list(segment_list&&) = default;
+        segment_list(const segment_list&) = default;
+        segment_list& operator=(segment_list&&) = default;
+        segment_list& operator=(const segment_list& other)
+        {
+            auto tmp = other;
+            this->swap(tmp);
+            return *this;
+        }
+    };
+
+    // Segments of unique interfaces can't be copied, nor can interface_vectors of them.
+    template<typename I>
+    using segments_t = std::conditional_t<std::is_copy_constructible_v<I>, segment_list<I>, move_only<segment_list<I>>>;
+}
+
+// Container of objects convertible to the interface I, keeping one contiguous
+// std::vector per stored type, keyed by the thunk acting as RTTI.
+// Objects are visited type by type, in insertion order within each type.
+template<typename I>
+class interface_vector
+{
+    static_assert(::interface_detail::is_interface_v<I>, "interface_vector requires an interface.");
+    static_assert(!is_sealed(static_cast<I*>(nullptr), ::interface_detail::interface_tag{}),
+                  "interface_vector doesn't support sealed interfaces, which can't refer to its objects.");
+
+  public:
+    template<typename T, typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        static_assert(!::std::is_pointer_v<T>, "interface_vector stores objects, not pointers.");
+        auto& v = objects<T>();
+        return v.emplace_back(::std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    ::std::decay_t<T>& push_back(T&& t)
+    {
+        return emplace_back<::std::decay_t<T>>(::std::forward<T>(t));
+    }
+
+    // Contiguous storage of all objects of type T, which may be modified directly.
+    template<typename T>
+    ::std::vector<T>& objects()
+    {
+        if constexpr(::std::is_copy_constructible_v<I>)
+            static_assert(::std::is_copy_constructible_v<T>, "Value semantics require the type be copy constructible.");
+        auto t = ::interface_detail::get_thunk<T>();
+        for(auto& s : _segments)
+            if(s.type() == t)
+                return s.template objects<T>();
+        _segments.emplace_back(::std::in_place_type<T>);
+        return _segments.back().template objects<T>();
+    }
+
+    ::std::size_t size() const noexcept
+    {
+        ::std::size_t n = 0;
+        for(auto& s : _segments)
+            n += s.size();
+        return n;
+    }
+    bool empty() const noexcept { return size() == 0; }
+
+    // Keeps the segments, and thus their capacity.
+    void clear() noexcept
+    {
+        for(auto& s : _segments)
+            s.clear();
+    }
+
+    // Calls f with an interface referring to each object.
+    template<typename F>
+    void for_each(F f)
+    {
+        for(auto& s : _segments)
+            s.for_each(f);
+    }
+
+    // Calls a method on each object, as interface_detail::for_each_call.
+    // method is made by INTERFACE_METHOD.
+    template<typename Method, typename... Args>
+    void for_each_call(Method method, Args&&... args)
+    {
+        for(auto& s : _segments)
+            s.for_each_call(method, args...);
+    }
+
+  private:
+    ::interface_detail::segments_t<I> _segments;
+};
+
+#endif // INTERFACE_VECTOR_HPP_INCLUDED
@@ -0,0 +1,83 @@
+// Tests of memory accounting.
+
+#include <cstddef>
+#include <memory_resource>
+
+// Counts heap buffers and their bytes.
+struct hook
+{
+    static inline long bytes = 0;
+    static inline long count = 0;
+
+    static void allocate(std::size_t size, std::size_t, std::pmr::memory_resource*) noexcept
+    {
+        bytes += static_cast<long>(size);
+        ++count;
+    }
+    static void deallocate(std::size_t size, std::size_t, std::pmr::memory_resource*) noexcept
+    {
+        bytes -= static_cast<long>(size);
+        --count;
+    }
+};
+
+#define INTERFACE_ALLOCATION_HOOK hook
+#include <cassert>
+
+#include "common.hpp"
+
+namespace
+{
+    struct Small
+    {
+        int f() { return 1; }
+    };
+
+    struct Big
+    {
+        test::heap_pad pad = {};
+        int f() { return 2; }
+    };
+
+    using Interface = INTERFACE(int(), f);
+    using Shared = SHARED_INTERFACE(int(), f);
+    using Ref = INTERFACE_REF(int(), f);
+
+    // Only heap objects report their size, and every buffer is reported to the hook.
+    void storage()
+    {
+        Interface e;
+        Interface s = Small{};
+        assert(storage_size(e) == 0 && !is_inline(e));
+        assert(storage_size(s) == 0 && is_inline(s) && hook::count == 0);
+        {
+            Interface b = Big{};
+            assert(storage_size(b) == sizeof(Big) && !is_inline(b) && hook::bytes == sizeof(Big));
+            Interface c = b;
+            std::pmr::monotonic_buffer_resource mr;
+            Interface m{std::allocator_arg, &mr, Big{}};
+            assert(storage_size(m) == sizeof(Big) && hook::count == 3);
+        }
+        assert(hook::count == 0 && hook::bytes == 0);
+    }
+
+    // Pointers and references hold nothing, shared objects report the count in front of them.
+    void non_owning_and_shared()
+    {
+        Big big;
+        Interface p = &big;
+        Ref r = big;
+        assert(storage_size(p) == 0 && !is_inline(p) && storage_size(r) == 0 && !is_inline(r));
+
+        Shared x = Big{};
+        Shared y = x;
+        assert(storage_size(x) == sizeof(Big) + __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        assert(storage_size(y) == storage_size(x) && hook::count == 1);
+    }
+}
+
+int main()
+{
+    storage();
+    non_owning_and_shared();
+}
@@ -0,0 +1,65 @@
+// Tests of over-aligned types.
+
+#include <cassert>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "interface.hpp"
+
+namespace
+{
+    template<std::size_t Align>
+    bool aligned(const void* p)
+    {
+        return reinterpret_cast<std::uintptr_t>(p) % Align == 0;
+    }
+
+    struct alignas(64) Line
+    {
+        int n = 1;
+        int get() { return aligned<64>(this) ? n : -1; }
+    };
+
+    struct alignas(256) Page
+    {
+        int n = 2;
+        int get() { return aligned<256>(this) ? n : -1; }
+    };
+
+    using Getter = INTERFACE(int(), get);
+    using CompactGetter = INTERFACE_COMPACT(int(), get);
+    using SharedGetter = SHARED_INTERFACE(int(), get);
+
+    // Over-aligned objects stay aligned through copies, moves and allocation from resources.
+    template<typename I>
+    void over_aligned()
+    {
+        std::vector<I> v;
+        for(int k = 0; k < 16; ++k)
+        {
+            if(k % 2)
+                v.push_back(Line{});
+            else
+                v.push_back(Page{});
+        }
+        auto w = v;
+        int sum = 0;
+        for(auto& i : w)
+            sum += i.get();
+        assert(sum == 24);
+
+        std::pmr::unsynchronized_pool_resource mr;
+        I a{std::allocator_arg, &mr, Page{}};
+        I b = a;
+        target<Page>(b)->n = 5;
+        assert(a.get() == 2 && b.get() == 5);
+    }
+}
+
+int main()
+{
+    over_aligned<Getter>();
+    over_aligned<CompactGetter>();
+    over_aligned<SharedGetter>();
+}
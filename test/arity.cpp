@@ -0,0 +1,65 @@
+// Tests of interfaces with many methods.
+
+#include <cassert>
+
+#include "common.hpp"
+
+namespace
+{
+    // Method k returns k.
+    struct Service
+    {
+        int m0() { return 0; }
+        int m1() { return 1; }
+        int m2() { return 2; }
+        int m3() { return 3; }
+        int m4() { return 4; }
+        int m5() { return 5; }
+        int m6() { return 6; }
+        int m7() { return 7; }
+        int m8() { return 8; }
+        int m9() { return 9; }
+        int m10() { return 10; }
+        int m11() { return 11; }
+        int m12() { return 12; }
+        int m13() { return 13; }
+        int m14() { return 14; }
+        int m15() { return 15; }
+        int m16() { return 16; }
+        int m17() { return 17; }
+        int m18() { return 18; }
+        int m19(int x) const { return 19 + x; }
+    };
+
+    using Twenty = INTERFACE(int(), m0, int(), m1, int(), m2, int(), m3, int(), m4,
+                             int(), m5, int(), m6, int(), m7, int(), m8, int(), m9,
+                             int(), m10, int(), m11, int(), m12, int(), m13, int(), m14,
+                             int(), m15, int(), m16, int(), m17, int(), m18, int(int) const, m19);
+    using Ends = INTERFACE(int(int) const, m19, int(), m0);
+    using EndsRef = INTERFACE_REF(int(), m8, int(int) const, m19);
+
+    // Methods beyond the eighth are called like the first.
+    void call_methods()
+    {
+        Twenty t = Service{};
+        assert(t.m0() == 0 && t.m8() == 8 && t.m19(1) == 20);
+        const Twenty& c = t;
+        assert(c.m19(0) == 19);
+    }
+
+    // Interfaces with many methods convert to subsets by name, in any order.
+    void narrow()
+    {
+        Twenty t = Service{};
+        Ends e = t;
+        assert(e.m0() == 0 && e.m19(2) == 21);
+        EndsRef r = t;
+        assert(r.m8() == 8 && r.m19(3) == 22 && target<Service>(r) == target<Service>(t));
+    }
+}
+
+int main()
+{
+    call_methods();
+    narrow();
+}
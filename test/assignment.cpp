@@ -0,0 +1,76 @@
+// Tests of interface assignment.
+
+#include <cassert>
+#include <memory_resource>
+#include <stdexcept>
+
+#include "common.hpp"
+
+namespace
+{
+    struct Big
+    {
+        int n = 0;
+        test::heap_pad pad = {};
+        int get() { return n; }
+    };
+
+    bool fail = false;
+
+    // Same size as Big, but copies may throw.
+    struct Throwing
+    {
+        int n = 0;
+        test::heap_pad pad = {};
+        Throwing() = default;
+        Throwing(const Throwing& other) : n{other.n}
+        {
+            if(fail)
+                throw std::runtime_error{"copy"};
+        }
+        int get() { return n; }
+    };
+
+    using Getter = INTERFACE(int(), get);
+
+    // Nothrow copies reuse the buffer of the held object.
+    void reuse_buffer()
+    {
+        test::counting_resource mr;
+        Getter a{std::allocator_arg, &mr, Big{1}};
+        Getter b{std::allocator_arg, &mr, Big{2}};
+        assert(mr.allocs == 2);
+        a = b;
+        assert(a.get() == 2 && mr.allocs == 2);
+    }
+
+    // Throwing copies leave the assigned to interface unchanged.
+    void strong_guarantee()
+    {
+        test::counting_resource mr;
+        Getter a{std::allocator_arg, &mr, Big{1}};
+        Getter t{std::allocator_arg, &mr, Throwing{}};
+        Getter b{std::allocator_arg, &mr, Big{3}};
+        a = t;
+        assert(a.get() == 0 && target<Throwing>(a));
+
+        fail = true;
+        try
+        {
+            a = b;
+            a = t;
+            assert(false);
+        }
+        catch(std::runtime_error&)
+        {
+        }
+        fail = false;
+        assert(a.get() == 3 && target<Big>(a));
+    }
+}
+
+int main()
+{
+    reuse_buffer();
+    strong_guarantee();
+}
@@ -0,0 +1,95 @@
+// Tests of atomic_interface.
+
+#include <atomic>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "atomic_interface.hpp"
+#include "common.hpp"
+
+namespace
+{
+    std::atomic<int> alive{0};
+
+    // Counts live objects, so that retired interfaces are seen destroyed.
+    struct Handler
+    {
+        std::string name = test::long_string;
+        int n = 0;
+
+        explicit Handler(int n) : n{n} { ++alive; }
+        Handler(const Handler& other) : name{other.name}, n{other.n} { ++alive; }
+        ~Handler() { --alive; }
+
+        int get() const { return n; }
+    };
+
+    using Getter = INTERFACE(int() const, get);
+
+    void single_thread()
+    {
+        {
+            atomic_interface<Getter> a;
+            assert(!a.load());
+            a.store(Handler{1});
+            assert(a.load()->get() == 1);
+
+            auto old = a.exchange(Handler{2});
+            assert(old.get() == 1 && (*a.load()).get() == 2);
+
+            auto s = a.load();
+            auto t = std::move(s);
+            assert(!s && t->get() == 2);
+        }
+        assert(alive == 0);
+    }
+
+    // Readers only ever see whole interfaces while writers store and exchange them.
+    void concurrent()
+    {
+        {
+            atomic_interface<Getter, 4> a{Handler{0}};
+            std::atomic<bool> stop{false};
+            std::atomic<long> calls{0};
+
+            std::vector<std::thread> readers;
+            for(int k = 0; k < 4; ++k)
+                readers.emplace_back([&] {
+                    long c = 0;
+                    while(!stop)
+                    {
+                        auto s = a.load();
+                        auto n = s->get();
+                        assert(n >= 0 && n < 4000);
+                        ++c;
+                    }
+                    calls += c;
+                });
+
+            std::thread exchanger{[&] {
+                for(int k = 0; k < 2000; ++k)
+                    assert(a.exchange(Handler{2000 + k}).get() >= 0);
+            }};
+            for(int k = 0; k < 2000; ++k)
+                a.store(Handler{k});
+            exchanger.join();
+
+            stop = true;
+            for(auto& t : readers)
+                t.join();
+            assert(calls > 0);
+
+            // Every retired interface is destroyed, only the stored one is alive.
+            assert(alive == 1);
+        }
+        assert(alive == 0);
+    }
+}
+
+int main()
+{
+    single_thread();
+    concurrent();
+}
@@ -0,0 +1,53 @@
+// Tests of bound methods.
+
+#include <cassert>
+#include <string>
+#include <type_traits>
+
+#include "interface.hpp"
+
+namespace
+{
+    struct A
+    {
+        int n = 0;
+        int add(int k) { return n += k; }
+        std::string bang(const std::string& s) const { return s + "!"; }
+    };
+
+    using Adder = INTERFACE(int(int), add, std::string(const std::string&) const, bang);
+    using CompactAdder = INTERFACE_COMPACT(int(int), add);
+    using SealedAdder = SEALED_INTERFACE((A), int(int), add);
+
+    // Bound methods call the object of the interface, and are empty for empty interfaces.
+    template<typename I>
+    void bind()
+    {
+        I i = A{};
+        auto add = INTERFACE_BIND(i, add);
+        static_assert(std::is_trivially_copyable_v<decltype(add)>);
+        assert(add);
+        for(int k = 0; k < 10; ++k)
+            add(1);
+        assert(i.add(0) == 10);
+
+        I e;
+        assert(!INTERFACE_BIND(e, add));
+    }
+
+    // Const methods bind too, taking their arguments as the method does.
+    void bind_const()
+    {
+        Adder a = A{};
+        auto bang = INTERFACE_BIND(a, bang);
+        assert(bang("a") == "a!");
+    }
+}
+
+int main()
+{
+    bind<Adder>();
+    bind<CompactAdder>();
+    bind<SealedAdder>();
+    bind_const();
+}
@@ -0,0 +1,60 @@
+// Tests of bulk calls.
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+
+namespace
+{
+    struct Small
+    {
+        int n = 0;
+        void process(int& acc, int k)
+        {
+            acc += k;
+            ++n;
+        }
+    };
+
+    struct Big
+    {
+        std::string s = test::long_string;
+        void process(int& acc, int k) { acc += 2 * k; }
+    };
+
+    using Handler = INTERFACE(void(int&, int), process);
+    using CompactHandler = INTERFACE_COMPACT(void(int&, int), process);
+
+    // Each interface is called once with the same arguments, whatever order the types come in.
+    template<typename I>
+    void call_all()
+    {
+        Small s;
+        std::vector<I> v;
+        for(int k = 0; k < 6; ++k)
+        {
+            v.push_back(Small{});
+            if(k % 3 == 0)
+                v.push_back(Big{});
+        }
+        v.push_back(&s);
+
+        int acc = 0;
+        interface_detail::for_each_call(v.begin(), v.end(), INTERFACE_METHOD(process), acc, 3);
+        assert(acc == 6 * 3 + 2 * 6 + 3 && s.n == 1);
+        for(auto& i : v)
+            assert(!target<Small>(i) || target<Small>(i)->n == 1);
+
+        acc = 0;
+        interface_detail::for_each_call(v.begin(), v.begin(), INTERFACE_METHOD(process), acc, 3);
+        assert(acc == 0);
+    }
+}
+
+int main()
+{
+    call_all<Handler>();
+    call_all<CompactHandler>();
+}
@@ -0,0 +1,43 @@
+// Helpers shared by the tests, which are built and run by test/Makefile.
+// Each test is a program exiting with a failed assertion on error.
+// Tests configuring interface through macros define them before including this.
+
+#ifndef INTERFACE_TEST_COMMON_HPP_INCLUDED
+#define INTERFACE_TEST_COMMON_HPP_INCLUDED
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "interface.hpp"
+
+namespace test
+{
+    // Counts the allocations made through it and those yet to be deallocated.
+    struct counting_resource : std::pmr::memory_resource
+    {
+        int allocs = 0;
+        int live = 0;
+
+        void* do_allocate(std::size_t bytes, std::size_t align) override
+        {
+            ++allocs;
+            ++live;
+            return std::pmr::new_delete_resource()->allocate(bytes, align);
+        }
+        void do_deallocate(void* p, std::size_t bytes, std::size_t align) override
+        {
+            --live;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    // Member of types too large for the inline buffer, whatever its size, hence stored on the heap.
+    // Trivially copyable, so that copies don't throw.
+    using heap_pad = char[2 * interface_detail::sbo_size];
+
+    // Too long for the small string optimization, copies of types holding it allocate and may throw.
+    inline constexpr const char* long_string = "a string too long for the small string optimization";
+}
+
+#endif // INTERFACE_TEST_COMMON_HPP_INCLUDED
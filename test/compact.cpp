@@ -0,0 +1,82 @@
+// Tests of compact interfaces.
+
+#include <cassert>
+#include <utility>
+
+#include "common.hpp"
+
+namespace
+{
+    struct Small
+    {
+        int n = 1;
+        int a() { return n; }
+        int b() { return 2; }
+        int c(int x) { return x; }
+    };
+
+    struct Big
+    {
+        test::heap_pad pad = {};
+        int n = 3;
+        int a() { return n; }
+        int b() { return 4; }
+        int c(int x) { return -x; }
+    };
+
+    using One = INTERFACE_COMPACT(int(), a);
+    using Three = INTERFACE_COMPACT(int(), a, int(), b, int(int), c);
+    using Object = INTERFACE(int(), a, int(), b);
+
+    // Objects only point to the table of their type, whatever the number of methods.
+    static_assert(sizeof(One) == sizeof(Three));
+
+    // Tables start a cache line, and the thunk leaves room in it for the first method.
+    using Table = interface_detail::method_table<interface_detail::vtable_type<void, int (*)(void*)>>;
+    static_assert(alignof(Table) == 64 && sizeof(interface_detail::thunk) + sizeof(void*) <= 64);
+
+    void methods()
+    {
+        Three s = Small{};
+        Three b = Big{};
+        assert(s.a() == 1 && s.b() == 2 && s.c(5) == 5);
+        assert(b.a() == 3 && b.b() == 4 && b.c(5) == -5);
+        assert(target<Small>(s) && !target<Big>(s));
+    }
+
+    // Copy, move and destruction go through the same table.
+    void copy_move()
+    {
+        Three a = Big{};
+        Three b = a;
+        target<Big>(b)->n = 5;
+        assert(a.a() == 3 && b.a() == 5);
+
+        Three c = std::move(b);
+        assert(!b && c.a() == 5);
+
+        Three d = Small{};
+        swap(c, d);
+        assert(c.a() == 1 && d.a() == 5);
+
+        Small s;
+        Three p = &s;
+        s.n = 7;
+        assert(p.a() == 7);
+    }
+
+    // Compact interfaces convert to object layouts, the methods are looked up by name.
+    void convert()
+    {
+        Three a = Big{};
+        Object o = a;
+        assert(o.a() == 3 && o.b() == 4);
+    }
+}
+
+int main()
+{
+    methods();
+    copy_move();
+    convert();
+}
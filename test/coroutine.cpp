@@ -0,0 +1,104 @@
+// Tests of coroutines returned by interface methods.
+
+#include <cassert>
+#include <coroutine>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "common.hpp"
+
+namespace
+{
+    template<typename T>
+    struct task
+    {
+        struct promise_type : interface_frame_allocator
+        {
+            T value{};
+
+            task get_return_object() { return task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_value(T v) { value = v; }
+            void unhandled_exception() { throw; }
+        };
+
+        explicit task(std::coroutine_handle<promise_type> h) : h{h} {}
+        task(task&& other) noexcept : h{std::exchange(other.h, {})} {}
+        ~task()
+        {
+            if(h)
+                h.destroy();
+        }
+
+        T get()
+        {
+            h.resume();
+            return h.promise().value;
+        }
+
+        std::coroutine_handle<promise_type> h;
+    };
+
+    // Stateless, hence stored inline.
+    struct RpcHandler
+    {
+        task<int> handle(int request) { co_return request + 1; }
+        int count() { return 0; }
+    };
+
+    struct BigHandler
+    {
+        test::heap_pad pad = {};
+        task<int> handle(int request) { co_return request + 2; }
+    };
+
+    using Handler = INTERFACE(task<int>(int), handle);
+    using Counter = INTERFACE(int(), count);
+
+    // Frames are allocated from the resource of the interface, wherever its object is stored.
+    void frame_resource()
+    {
+        test::counting_resource mr;
+        {
+            Handler h{std::allocator_arg, &mr, RpcHandler{}};
+            assert(is_inline(h) && mr.allocs == 0);
+            auto t = h.handle(1);
+            assert(mr.allocs == 1);
+            assert(t.get() == 2);
+
+            Handler b{std::allocator_arg, &mr, BigHandler{}};
+            assert(mr.allocs == 2);
+            auto u = b.handle(1);
+            assert(mr.allocs == 3 && u.get() == 3);
+        }
+        assert(mr.live == 0);
+
+        Handler h = RpcHandler{};
+        assert(h.handle(2).get() == 3 && mr.allocs == 3);
+    }
+
+    // Bound methods and bulk calls allocate frames from the resource of the object too.
+    void bound_and_bulk()
+    {
+        test::counting_resource mr;
+        Handler h{std::allocator_arg, &mr, RpcHandler{}};
+        auto handle = INTERFACE_BIND(h, handle);
+        assert(handle(1).get() == 2 && mr.allocs == 1);
+
+        std::vector<Handler> v(3, h);
+        interface_detail::for_each_call(v.begin(), v.end(), INTERFACE_METHOD(handle), 1);
+        assert(mr.allocs == 4 && mr.live == 0);
+
+        // Bound methods of other return types keep no resource.
+        Counter c = RpcHandler{};
+        static_assert(sizeof(INTERFACE_BIND(c, count)) == 2 * sizeof(void*));
+    }
+}
+
+int main()
+{
+    frame_resource();
+    bound_and_bulk();
+}
@@ -0,0 +1,70 @@
+// Tests of INTERFACE_FORWARD_ARGUMENTS.
+
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+#define INTERFACE_FORWARD_ARGUMENTS
+#include "interface.hpp"
+
+namespace
+{
+    // Counts its copies and moves.
+    struct Counted
+    {
+        static inline int copies = 0;
+        static inline int moves = 0;
+
+        Counted() = default;
+        Counted(const Counted&) { ++copies; }
+        Counted(Counted&&) noexcept { ++moves; }
+
+        static void reset() { copies = moves = 0; }
+    };
+
+    struct A
+    {
+        void take(Counted) {}
+        void look(Counted) const {}
+    };
+
+    using Taker = INTERFACE(void(Counted), take, void(Counted) const, look);
+
+    // Objects are passed by rvalue reference, scalars and references as is.
+    static_assert(std::is_same_v<interface_detail::erasure_fn<void(Counted, int, const Counted&)>::type,
+                                 void(void*, Counted&&, int, const Counted&)>);
+
+    // Rvalues are moved once into the method's parameter, lvalues are copied for the call then moved.
+    template<typename F>
+    void count(F&& f)
+    {
+        Counted c;
+        Counted::reset();
+        f(Counted{});
+        assert(Counted::copies == 0 && Counted::moves == 1);
+
+        Counted::reset();
+        f(c);
+        assert(Counted::copies == 1 && Counted::moves == 1);
+    }
+
+    void forward()
+    {
+        Taker t = A{};
+        count([&](auto&& c) { t.take(std::forward<decltype(c)>(c)); });
+
+        const Taker& ct = t;
+        count([&](auto&& c) { ct.look(std::forward<decltype(c)>(c)); });
+
+        auto take = INTERFACE_BIND(t, take);
+        count([&](auto&& c) { take(std::forward<decltype(c)>(c)); });
+
+        auto look = INTERFACE_BIND(t, look);
+        count([&](auto&& c) { look(std::forward<decltype(c)>(c)); });
+    }
+}
+
+int main()
+{
+    forward();
+}
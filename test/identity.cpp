@@ -0,0 +1,107 @@
+// Tests of identity comparison, ordering and hashing, and of value equality.
+
+#include <cassert>
+#include <set>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#define INTERFACE_VALUE_EQUALITY
+#include "common.hpp"
+
+namespace
+{
+    struct Small
+    {
+        int n = 0;
+        void notify() {}
+    };
+
+    struct Big
+    {
+        test::heap_pad pad = {};
+        void notify() {}
+    };
+
+    struct Value
+    {
+        int n = 0;
+        void notify() {}
+        bool operator==(const Value& other) const { return n == other.n; }
+    };
+
+    using Subscriber = INTERFACE(void(), notify);
+    using SharedSubscriber = SHARED_INTERFACE(void(), notify);
+    using SubscriberRef = INTERFACE_REF(void(), notify);
+
+    template<typename I, typename = void>
+    struct is_ordered : std::false_type {};
+
+    template<typename I>
+    struct is_ordered<I, std::void_t<decltype(std::declval<const I&>() < std::declval<const I&>())>> : std::true_type {};
+
+    // Owning interfaces copy and move their objects, which have no identity to order or hash by.
+    static_assert(!is_ordered<Subscriber>::value && !is_ordered<SharedSubscriber>::value);
+    static_assert(is_ordered<SubscriberRef>::value);
+
+    // Interface references are keys by the object they refer to, whatever its size.
+    void reference_keys()
+    {
+        std::vector<Small> small(100);
+        std::vector<Big> big(100);
+        std::set<SubscriberRef> ordered;
+        std::unordered_set<SubscriberRef, interface_hash> hashed;
+        for(int k = 0; k < 100; ++k)
+        {
+            ordered.insert(small[k]);
+            ordered.insert(SubscriberRef{big[k]});
+            hashed.insert(small[k]);
+            hashed.insert(SubscriberRef{big[k]});
+        }
+        ordered.insert(small[0]);
+        hashed.insert(small[0]);
+        assert(ordered.size() == 200 && hashed.size() == 200);
+
+        for(int k = 0; k < 100; ++k)
+        {
+            assert(ordered.count(small[k]) == 1 && ordered.count(big[k]) == 1);
+            assert(hashed.count(small[k]) == 1 && hashed.count(big[k]) == 1);
+        }
+        for(auto& s : ordered)
+            assert(ordered.count(s) == 1);
+        for(auto& s : hashed)
+            assert(hashed.count(s) == 1 && hashed.bucket_size(hashed.bucket(s)) < 8);
+    }
+
+    // References to the objects of owning interfaces are keys by the owned object.
+    void owned_objects()
+    {
+        Subscriber a = Small{};
+        Subscriber b = Big{};
+        std::unordered_set<SubscriberRef, interface_hash> hashed{a, b};
+        assert(hashed.size() == 2 && hashed.count(a) == 1 && hashed.count(b) == 1);
+        Subscriber c = a;
+        assert(hashed.count(c) == 0);
+    }
+
+    // Objects of the same equality comparable type compare by value, others as by operator==.
+    void value_equality()
+    {
+        Subscriber one = Value{1};
+        assert(equal_values(one, Subscriber{Value{1}}) && !equal_values(one, Subscriber{Value{2}}));
+        assert(one != Subscriber{Value{1}});
+
+        Subscriber small = Small{};
+        assert(equal_values(small, small) && !equal_values(small, Subscriber{Small{}}));
+        assert(!equal_values(one, small) && !equal_values(one, Subscriber{}));
+        assert(equal_values(Subscriber{}, Subscriber{}));
+    }
+}
+
+int main()
+{
+    reference_keys();
+    owned_objects();
+    value_equality();
+}
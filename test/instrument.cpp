@@ -0,0 +1,71 @@
+// Tests of INTERFACE_INSTRUMENT.
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+namespace interface_detail
+{
+    struct thunk;
+}
+
+// Records calls per method of each interface, and whether a call is ongoing.
+template<typename Interface>
+struct probe
+{
+    static inline int calls[2] = {};
+    static inline const char* last = nullptr;
+    static inline const interface_detail::thunk* type = nullptr;
+    static inline int depth = 0;
+
+    probe(const char* name, std::size_t index, const interface_detail::thunk* t) noexcept
+    {
+        ++calls[index];
+        last = name;
+        type = t;
+        ++depth;
+    }
+    ~probe() { --depth; }
+};
+
+#define INTERFACE_INSTRUMENT probe
+#include "interface.hpp"
+
+namespace
+{
+    struct A
+    {
+        int f() { return probe_depth(); }
+        int g(int x) const noexcept { return x; }
+
+        static int probe_depth();
+    };
+
+    using Instrumented = INTERFACE(int(), f, int(int) const noexcept, g);
+    using Sealed = SEALED_INTERFACE((A), int(), f);
+
+    int A::probe_depth() { return probe<Instrumented>::depth; }
+
+    // Each call constructs a probe for its method before calling, and destroys it after.
+    void count_calls()
+    {
+        Instrumented i = A{};
+        assert(i.f() == 1 && i.f() == 1);
+        const Instrumented& c = i;
+        assert(c.g(3) == 3);
+
+        assert(probe<Instrumented>::calls[0] == 2 && probe<Instrumented>::calls[1] == 1);
+        assert(std::strcmp(probe<Instrumented>::last, "g") == 0);
+        assert(probe<Instrumented>::type == interface_detail::get_thunk<A>());
+        assert(probe<Instrumented>::depth == 0);
+
+        Sealed s = A{};
+        s.f();
+        assert(probe<Sealed>::calls[0] == 1 && probe<Instrumented>::calls[0] == 2);
+    }
+}
+
+int main()
+{
+    count_calls();
+}
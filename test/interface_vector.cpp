@@ -0,0 +1,94 @@
+// Tests of interface_vector.
+
+#include <cassert>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "common.hpp"
+#include "interface_vector.hpp"
+
+namespace
+{
+    struct Small
+    {
+        int n = 0;
+        void process(int& acc, int k)
+        {
+            acc += k;
+            ++n;
+        }
+        int id() { return 1; }
+    };
+
+    struct Big
+    {
+        std::string s = test::long_string;
+        void process(int& acc, int k) { acc += 2 * k; }
+        int id() { return 2; }
+    };
+
+    struct MoveOnly
+    {
+        std::unique_ptr<int> p = std::make_unique<int>(3);
+        void process(int& acc, int) { acc += *p; }
+    };
+
+    using Handler = INTERFACE(void(int&, int), process, int(), id);
+    using UniqueHandler = UNIQUE_INTERFACE(void(int&, int), process);
+
+    // Only vectors of copyable interfaces are copyable.
+    static_assert(std::is_copy_constructible_v<interface_vector<Handler>> && std::is_copy_assignable_v<interface_vector<Handler>>);
+    static_assert(!std::is_copy_constructible_v<interface_vector<UniqueHandler>> &&
+                  !std::is_copy_assignable_v<interface_vector<UniqueHandler>>);
+    static_assert(std::is_nothrow_move_constructible_v<interface_vector<UniqueHandler>>);
+
+    // Objects are grouped by type, each group called through one method.
+    void segments()
+    {
+        interface_vector<Handler> v;
+        for(int k = 0; k < 10; ++k)
+        {
+            v.push_back(Small{});
+            v.emplace_back<Big>();
+        }
+        assert(v.size() == 20 && !v.empty());
+
+        int acc = 0;
+        v.for_each_call(INTERFACE_METHOD(process), acc, 3);
+        assert(acc == 90);
+        for(auto& s : v.objects<Small>())
+            assert(s.n == 1);
+
+        int ids = 0;
+        v.for_each([&](Handler h) { ids += h.id(); });
+        assert(ids == 30);
+    }
+
+    void copy_move()
+    {
+        interface_vector<Handler> v;
+        v.push_back(Small{});
+        v.push_back(Big{});
+
+        auto w = v;
+        w.clear();
+        assert(w.empty() && v.size() == 2);
+        w = v;
+        assert(w.size() == 2);
+
+        interface_vector<UniqueHandler> u;
+        u.push_back(MoveOnly{});
+        auto m = std::move(u);
+        int acc = 0;
+        m.for_each_call(INTERFACE_METHOD(process), acc, 0);
+        assert(acc == 3);
+    }
+}
+
+int main()
+{
+    segments();
+    copy_move();
+}
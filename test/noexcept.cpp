@@ -0,0 +1,59 @@
+// Tests of noexcept signatures.
+
+#include <cassert>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "interface.hpp"
+
+namespace
+{
+    struct Ticker
+    {
+        int n = 0;
+        void tick() noexcept { ++n; }
+        int get() const noexcept { return n; }
+        void name(std::string) noexcept {}
+    };
+
+    using Noexcept = INTERFACE(void() noexcept, tick, int() const noexcept, get, void(std::string) noexcept, name);
+    using Throwing = INTERFACE(void(), tick);
+    using SealedNoexcept = SEALED_INTERFACE((Ticker), void() noexcept, tick);
+    using NoexceptRef = INTERFACE_REF(void() noexcept, tick);
+
+    // Methods are noexcept iff the signature is, and the arguments convert without throwing.
+    static_assert(noexcept(std::declval<Noexcept&>().tick()));
+    static_assert(noexcept(std::declval<const Noexcept&>().get()));
+    static_assert(noexcept(std::declval<Noexcept&>().name(std::string{})));
+    static_assert(!noexcept(std::declval<Noexcept&>().name("converted")));
+    static_assert(!noexcept(std::declval<Throwing&>().tick()));
+    static_assert(noexcept(std::declval<SealedNoexcept&>().tick()));
+    static_assert(noexcept(std::declval<NoexceptRef&>().tick()));
+
+    // The type erased call keeps noexcept, through slots and bound methods.
+    void propagate()
+    {
+        Noexcept t = Ticker{};
+        auto slot = INTERFACE_METHOD(tick);
+        static_assert(std::is_same_v<decltype(slot(t)), void (*)(void*) noexcept>);
+        t.tick();
+
+        auto tick = INTERFACE_BIND(t, tick);
+        static_assert(noexcept(tick()));
+        tick();
+
+        NoexceptRef r = t;
+        r.tick();
+        assert(t.get() == 3);
+
+        Throwing w = t;
+        w.tick();
+        assert(target<Ticker>(w)->n == 4);
+    }
+}
+
+int main()
+{
+    propagate();
+}
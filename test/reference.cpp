@@ -0,0 +1,162 @@
+// Tests of interface references.
+
+#include <cassert>
+#include <string>
+
+#include "common.hpp"
+
+namespace
+{
+    struct S
+    {
+        std::string s = test::long_string;
+        std::size_t size() { return s.size(); }
+    };
+
+    using Fooer = INTERFACE(std::size_t(), size);
+    using RFooer = INTERFACE_REF(std::size_t(), size);
+
+    using OtherRFooer = INTERFACE_REF(std::size_t(), size);
+
+    struct Stateless
+    {
+        int handle() { return 1; }
+    };
+
+    struct Counter
+    {
+        int n = 0;
+        int handle() { return ++n; }
+    };
+
+    using Handler = INTERFACE_REF(int(), handle);
+
+    Counter counter;
+    constexpr Handler handlers[] = {Stateless{}, &counter};
+
+    // Move only, so interface references to it can't be converted to owning interfaces.
+    struct Pinned
+    {
+        Pinned() = default;
+        Pinned(Pinned&&) = default;
+        std::size_t size() { return 0; }
+    };
+
+    using RPinned = INTERFACE_REF(std::size_t(), size);
+    using UPinned = UNIQUE_INTERFACE(std::size_t(), size);
+
+    struct Reader
+    {
+        int n = 1;
+        int get() const { return n; }
+    };
+
+    using Getter = INTERFACE(int() const, get);
+    using SharedGetter = SHARED_INTERFACE(int() const, get);
+    using RGetter = INTERFACE_REF(int() const, get);
+
+    int read(RGetter r) { return r.get(); }
+
+    RFooer view(S& s) { return s; }
+    std::size_t take(Fooer f) { return f.size(); }
+
+    // Converting a reference to an owning interface copies the object, even from rvalues.
+    void convert_rvalue_reference()
+    {
+        S a;
+        auto n = a.s.size();
+        Fooer f = view(a);
+        assert(f.size() == n && a.s.size() == n);
+        assert(take(RFooer{a}) == n && a.s.size() == n);
+        Fooer g{std::allocator_arg, nullptr, RFooer{a}};
+        assert(g.size() == n && a.s.size() == n);
+    }
+
+    // Converting a reference to an object that can't be copied throws.
+    void convert_uncopyable_reference()
+    {
+        Pinned a;
+        RPinned r = a;
+        bool thrown = false;
+        try
+        {
+            UPinned u = r;
+        }
+        catch(bad_interface_copy&)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+
+        thrown = false;
+        try
+        {
+            Fooer f = RFooer{r};
+        }
+        catch(bad_interface_copy&)
+        {
+            thrown = true;
+        }
+        assert(thrown && a.size() == 0);
+    }
+
+    // References refer to the objects of unique interfaces, which they never copy.
+    void refer_to_unique()
+    {
+        UPinned u = Pinned{};
+        RPinned r = u;
+        assert(r.size() == 0 && target<Pinned>(r) == target<Pinned>(u));
+    }
+
+    // Constness of references is shallow, const references convert to other references.
+    // References to const owning interfaces don't compile.
+    void convert_const_reference()
+    {
+        S a;
+        const RFooer r = a;
+        OtherRFooer o = r;
+        assert(o.size() == a.s.size());
+    }
+
+    // References with only const methods refer to const objects and const interfaces.
+    void refer_to_const()
+    {
+        const Reader r;
+        assert(read(r) == 1);
+
+        const Getter g = Reader{};
+        const SharedGetter s = Reader{};
+        assert(read(g) == 1 && read(s) == 1);
+    }
+
+    // Tables of references are const, yet call non-const methods of the objects they refer to.
+    void call_constexpr_table()
+    {
+        assert(handlers[0].handle() == 1);
+        assert(handlers[1].handle() == 1 && handlers[1].handle() == 2 && counter.n == 2);
+    }
+
+    // Pointers held for reference semantics are their own target, returned by value.
+    void target_pointer()
+    {
+        S s;
+        Fooer f = &s;
+        const Fooer c = &s;
+        RFooer r = &s;
+        assert(target<S*>(f) == &s && target<S*>(c) == &s && target<S*>(r) == &s && !target<S>(f));
+        assert(!target<S*>(Fooer{S{}}) && !target<S>(r));
+        target<S*>(f)->s = "x";
+        assert(f.size() == 1);
+    }
+}
+
+int main()
+{
+    convert_rvalue_reference();
+    convert_uncopyable_reference();
+    refer_to_unique();
+    convert_const_reference();
+    refer_to_const();
+    call_constexpr_table();
+    target_pointer();
+}
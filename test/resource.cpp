@@ -0,0 +1,138 @@
+// Tests of memory resources.
+
+#include <cassert>
+#include <memory_resource>
+
+#include "common.hpp"
+
+namespace
+{
+    struct Small
+    {
+        int get() { return 1; }
+    };
+
+    struct Big
+    {
+        test::heap_pad pad = {};
+        int get() { return 2; }
+        int twice() { return 4; }
+    };
+
+    int moves = 0;
+
+    // Move only, counting its moves.
+    struct Pinned
+    {
+        test::heap_pad pad = {};
+        int n = 3;
+        Pinned() = default;
+        explicit Pinned(int n) : n{n} {}
+        Pinned(Pinned&& other) noexcept : n{other.n} { ++moves; }
+        int get() { return n; }
+    };
+
+    // Copyable but not movable, hence copied wherever it would be moved.
+    struct CopyOnly
+    {
+        test::heap_pad pad = {};
+        int n = 5;
+        CopyOnly() = default;
+        CopyOnly(const CopyOnly&) = default;
+        CopyOnly(CopyOnly&&) = delete;
+        int get() { return n; }
+    };
+
+    // As large as Big, so that it is constructed into the buffer of a Big.
+    struct Throwing
+    {
+        test::heap_pad pad = {};
+        Throwing() { throw 0; }
+        int get() { return 0; }
+    };
+
+    using Getter = INTERFACE(int(), get);
+    using UniqueGetter = UNIQUE_INTERFACE(int(), get);
+    using Doubler = INTERFACE(int(), get, int(), twice);
+
+    // Inline objects remember the resource they were constructed with.
+    void inline_resource()
+    {
+        test::counting_resource mr;
+        Getter a{std::allocator_arg, &mr, Small{}};
+        assert(is_inline(a) && mr.allocs == 0);
+
+        Getter b = a;
+        b.emplace<Big>();
+        assert(b.get() == 2 && mr.allocs == 1);
+
+        Getter c = std::move(a);
+        swap(b, c);
+        b.emplace<Big>();
+        assert(b.get() == 2 && mr.allocs == 2);
+    }
+
+    // In place construction allocates from the given resource, without moving.
+    void in_place_resource()
+    {
+        test::counting_resource mr;
+        UniqueGetter a{std::allocator_arg, &mr, std::in_place_type<Pinned>};
+        assert(a.get() == 3 && mr.allocs == 1);
+        UniqueGetter b{std::allocator_arg, &mr, std::in_place_type<Pinned>, 4};
+        assert(b.get() == 4 && mr.allocs == 2 && moves == 0);
+        Getter c{std::allocator_arg, &mr, std::in_place_type<Big>};
+        assert(c.get() == 2 && mr.allocs == 3);
+    }
+
+    // Moving to another resource copies objects which can't be moved.
+    void copy_only()
+    {
+        test::counting_resource mr, other;
+        Getter a{std::allocator_arg, &mr, std::in_place_type<CopyOnly>};
+        Getter b{std::allocator_arg, &other, std::move(a)};
+        assert(b.get() == 5 && mr.allocs == 1 && other.allocs == 1);
+    }
+
+    // Converting from an rvalue of another interface adopts its heap object if their resources are equal,
+    // and otherwise moves it into a buffer from the new resource, leaving the moved from object.
+    void adopt_converted()
+    {
+        test::counting_resource mr, other;
+        Doubler a{std::allocator_arg, &mr, Big{}};
+        Getter b = std::move(a);
+        assert(b.get() == 2 && !a && mr.allocs == 1 && mr.live == 1);
+
+        Doubler c{std::allocator_arg, &mr, Big{}};
+        Getter d{std::allocator_arg, &other, std::move(c)};
+        assert(d.get() == 2 && c && mr.allocs == 2 && mr.live == 2 && other.allocs == 1);
+    }
+
+    // emplace reuses the heap buffer of an object of the same size, and leaves the interface empty if it throws.
+    void emplace_reuse()
+    {
+        test::counting_resource mr;
+        Getter a{std::allocator_arg, &mr, Big{}};
+        a.emplace<Big>();
+        assert(a.get() == 2 && mr.allocs == 1 && mr.live == 1);
+
+        bool thrown = false;
+        try
+        {
+            a.emplace<Throwing>();
+        }
+        catch(int)
+        {
+            thrown = true;
+        }
+        assert(thrown && !a && mr.allocs == 1 && mr.live == 0);
+    }
+}
+
+int main()
+{
+    inline_resource();
+    in_place_resource();
+    copy_only();
+    adopt_converted();
+    emplace_reuse();
+}
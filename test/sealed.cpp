@@ -0,0 +1,89 @@
+// Tests of sealed interfaces.
+
+#include <cassert>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "interface.hpp"
+
+namespace
+{
+    struct A
+    {
+        int n = 1;
+        int get() { return n; }
+        std::string name(int k) { return "A" + std::to_string(k); }
+    };
+
+    struct B
+    {
+        std::string s = "b, a string too long for the small string optimization";
+        int get() { return 2; }
+        std::string name(int) { return s.substr(0, 1); }
+    };
+
+    struct C
+    {
+        int get() { return 3; }
+        const char* name(int) { return "C"; }
+    };
+
+    using Sealed = SEALED_INTERFACE((A, B, C, A*), int(), get, std::string(int), name);
+    using Getter = INTERFACE(int(), get);
+    using Compact = INTERFACE_COMPACT(int(), get, std::string(int), name);
+
+    // The index of the stored type takes the place of the method table pointer.
+    static_assert(sizeof(Sealed) == sizeof(Compact));
+
+    // Calls dispatch on the stored type among the sealed set, including pointers.
+    void dispatch()
+    {
+        A a{9};
+        std::vector<Sealed> v{A{}, B{}, C{}, &a};
+        int sum = 0;
+        for(auto& s : v)
+            sum += s.get();
+        assert(sum == 15);
+        assert(v[0].name(3) == "A3" && v[1].name(0) == "b" && v[2].name(0) == "C");
+        assert(target<B>(v[1]) && !target<A>(v[1]) && target<A*>(v[3]) == &a);
+    }
+
+    void copy_move_convert()
+    {
+        std::vector<Sealed> v{A{}, B{}, C{}};
+        auto w = v;
+        swap(w[0], w[1]);
+        assert(w[0].get() == 2 && w[1].get() == 1);
+
+        Sealed m = std::move(w[2]);
+        assert(m.get() == 3);
+
+        Getter g = v[1];
+        assert(g.get() == 2);
+
+        std::pmr::monotonic_buffer_resource mr;
+        Sealed r{std::allocator_arg, &mr, v[1]};
+        assert(r.get() == 2);
+    }
+
+    // Vtable slots are the methods of the stored type, as used by bulk calls and bound methods.
+    void slots()
+    {
+        std::vector<Sealed> v{A{}, A{}, B{}, C{}};
+        auto slot = INTERFACE_METHOD(get);
+        assert(slot(v[0]) == slot(v[1]) && slot(v[0]) != slot(v[2]) && slot(v[2]) != slot(v[3]));
+        int sum = 0;
+        for(auto& s : v)
+            sum += INTERFACE_BIND(s, get)();
+        assert(sum == 7);
+    }
+}
+
+int main()
+{
+    dispatch();
+    copy_move_convert();
+    slots();
+}
@@ -0,0 +1,117 @@
+// Tests of shared interfaces.
+
+#include <cassert>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common.hpp"
+
+namespace
+{
+    // Too large for the inline buffer, hence shared.
+    struct Counter
+    {
+        int n = 0;
+        test::heap_pad pad = {};
+        void inc() { ++n; }
+        int get() const noexcept { return n; }
+    };
+
+    using Shared = SHARED_INTERFACE(void(), inc, int() const noexcept, get);
+    using Incrementer = INTERFACE(void(), inc);
+    using IncrementerRef = INTERFACE_REF(void(), inc);
+    using LocalShared = LOCAL_SHARED_INTERFACE(void(), inc, int() const noexcept, get);
+
+    // Copyable but not movable.
+    struct CopyOnly
+    {
+        test::heap_pad pad = {};
+        CopyOnly() = default;
+        CopyOnly(const CopyOnly&) = default;
+        CopyOnly(CopyOnly&&) = delete;
+        std::size_t size() const noexcept { return 1; }
+    };
+
+    // Moves leave the source without its heap allocated string.
+    struct Named
+    {
+        std::string s = test::long_string;
+        std::size_t size() const noexcept { return s.size(); }
+    };
+
+    using SharedSizer = SHARED_INTERFACE(std::size_t() const noexcept, size);
+    using Sizer = INTERFACE(std::size_t() const noexcept, size);
+    using UniqueSizer = UNIQUE_INTERFACE(std::size_t() const noexcept, size);
+    using LocalSharedSizer = LOCAL_SHARED_INTERFACE(std::size_t() const noexcept, size);
+
+    template<typename I>
+    int count(I& i)
+    {
+        return target<Counter>(std::as_const(i))->n;
+    }
+
+    // Non-const methods unshare the object before mutating it, const methods don't.
+    template<typename I>
+    void copy_on_write()
+    {
+        I a = Counter{};
+        I b = a;
+        assert(b.get() == 0 && a == b);
+        b.inc();
+        assert(count(a) == 0 && count(b) == 1 && a != b);
+        static_assert(!noexcept(b.inc()));
+        static_assert(noexcept(b.get()));
+
+        I c = a;
+        auto inc = INTERFACE_BIND(c, inc);
+        inc();
+        assert(count(a) == 0 && count(c) == 1);
+
+        std::vector<I> v(3, a);
+        interface_detail::for_each_call(v.begin(), v.end(), INTERFACE_METHOD(inc));
+        assert(count(a) == 0);
+        for(auto& i : v)
+            assert(count(i) == 1);
+
+        I d = a;
+        Incrementer f = borrow(d);
+        f.inc();
+        assert(count(a) == 0 && count(d) == 1);
+        static_assert(!noexcept(borrow(d)));
+
+        I e = a;
+        IncrementerRef r = e;
+        r.inc();
+        assert(count(a) == 0 && count(e) == 1);
+    }
+
+    // Converting an rvalue to an interface counting differently leaves other owners their object.
+    template<typename I>
+    void convert_shared_rvalue()
+    {
+        SharedSizer a = Named{};
+        SharedSizer b = a;
+        auto n = b.size();
+        I i = std::move(a);
+        assert(i.size() == n && b.size() == n);
+
+        SharedSizer c = Named{};
+        I j = std::move(c);
+        assert(j.size() == n);
+
+        // Objects which can't be moved are copied instead.
+        SharedSizer d{std::in_place_type<CopyOnly>};
+        I k = std::move(d);
+        assert(k.size() == 1 && d.size() == 1);
+    }
+}
+
+int main()
+{
+    copy_on_write<Shared>();
+    copy_on_write<LocalShared>();
+    convert_shared_rvalue<Sizer>();
+    convert_shared_rvalue<UniqueSizer>();
+    convert_shared_rvalue<LocalSharedSizer>();
+}
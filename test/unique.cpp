@@ -0,0 +1,106 @@
+// Tests of unique interfaces.
+
+#include <cassert>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common.hpp"
+
+namespace
+{
+    struct Small
+    {
+        std::unique_ptr<int> p;
+        int run() { return *p; }
+    };
+
+    struct Big
+    {
+        std::unique_ptr<int> p;
+        test::heap_pad pad = {};
+        int run() { return *p + 1; }
+    };
+
+    // Declares a copy constructor that can't be instantiated.
+    struct Handler
+    {
+        std::vector<std::unique_ptr<int>> v;
+        int size() const { return static_cast<int>(v.size()); }
+        int run() { return size(); }
+    };
+
+    struct Copyable
+    {
+        int run() { return 3; }
+    };
+
+    using Task = UNIQUE_INTERFACE(int(), run);
+    using CopyableTask = INTERFACE(int(), run);
+    using Runner = UNIQUE_INTERFACE(int() const, size, int(), run);
+
+    static_assert(!std::is_copy_constructible_v<Task> && !std::is_copy_assignable_v<Task>);
+    static_assert(std::is_nothrow_move_constructible_v<Task>);
+
+    // Move only objects are stored inline and on the heap.
+    void move_only()
+    {
+        Task a = Small{std::make_unique<int>(1)};
+        Task b = Big{std::make_unique<int>(1)};
+        assert(a.run() == 1 && b.run() == 2);
+
+        Task c = std::move(a);
+        assert(!a && c.run() == 1);
+        swap(b, c);
+        assert(b.run() == 1 && c.run() == 2);
+        b = std::move(c);
+        assert(b.run() == 2 && !c);
+
+        std::vector<Task> v;
+        for(int k = 0; k < 20; ++k)
+            v.push_back(Small{std::make_unique<int>(k)});
+        int sum = 0;
+        for(auto& t : v)
+            sum += t.run();
+        assert(sum == 190);
+    }
+
+    // Types whose copy constructor is declared but ill-formed are stored without instantiating it.
+    void declared_copy()
+    {
+        static_assert(std::is_copy_constructible_v<Handler>);
+
+        Handler h;
+        h.v.push_back(std::make_unique<int>(1));
+        Task a = std::move(h);
+        assert(a.run() == 1 && target<Handler>(a)->v.size() == 1);
+
+        Task b{std::in_place_type<Handler>};
+        b.emplace<Handler>().v.resize(2);
+        assert(b.run() == 2);
+
+        a = std::move(b);
+        assert(a.run() == 2 && !b);
+
+        // Converting from other unique interfaces moves the object.
+        Runner r = Handler{};
+        Task c = std::move(r);
+        assert(c.run() == 0 && target<Handler>(c));
+    }
+
+    // Copyable interfaces convert to unique ones.
+    void from_copyable()
+    {
+        CopyableTask c = Copyable{};
+        Task t = c;
+        assert(t.run() == 3 && c.run() == 3);
+    }
+}
+
+int main()
+{
+    move_only();
+    declared_copy();
+    from_copyable();
+}